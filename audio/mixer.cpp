@@ -21,6 +21,7 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/profiler.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
@@ -299,6 +300,7 @@ void MixerImpl::playStream(
 }
 
 int MixerImpl::mixCallback(byte *samples, uint len) {
+	PROFILE_ZONE_THREAD("Mixer::mixCallback", Common::kProfilerThreadAudio);
 	assert(samples);
 
 	Common::StackLock lock(_mutex);
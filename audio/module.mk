@@ -24,6 +24,7 @@ MODULE_OBJS := \
 	musicplugin.o \
 	null.o \
 	rate.o \
+	samplecache.o \
 	timestamp.o \
 	decoders/3do.o \
 	decoders/aac.o \
@@ -0,0 +1,233 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/samplecache.h"
+#include "audio/audiostream.h"
+
+#include "common/array.h"
+#include "common/debug.h"
+#include "common/stream.h"
+
+namespace Common {
+DECLARE_SINGLETON(Audio::SampleCache);
+}
+
+namespace Audio {
+
+/** Memory the decoded samples may use by default, in bytes. */
+static const uint32 kDefaultMemoryBudget = 8 * 1024 * 1024;
+
+/**
+ * Samples larger than this fraction of the memory budget are not cached,
+ * so a single long sound cannot flush the whole cache.
+ */
+static const uint32 kMaxSampleFraction = 4;
+
+struct CachedSample {
+	Common::Array<int16> data;
+	int rate;
+	bool isStereo;
+
+	uint32 getSize() const { return data.size() * sizeof(int16); }
+};
+
+/**
+ * Stream playing a sample decoded by the cache.
+ */
+class CachedSampleStream : public SeekableAudioStream {
+public:
+	CachedSampleStream(const Common::SharedPtr<const CachedSample> &sample) : _sample(sample), _pos(0) {}
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		const uint32 count = MIN<uint32>(numSamples, _sample->data.size() - _pos);
+		if (count)
+			memcpy(buffer, &_sample->data[_pos], count * sizeof(int16));
+		_pos += count;
+		return count;
+	}
+
+	bool isStereo() const override  { return _sample->isStereo; }
+	bool endOfData() const override { return _pos >= _sample->data.size(); }
+	int getRate() const override    { return _sample->rate; }
+
+	Timestamp getLength() const override {
+		return Timestamp(0, _sample->data.size() / getChannels(), _sample->rate);
+	}
+
+	bool seek(const Timestamp &where) override {
+		const uint32 pos = where.convertToFramerate(_sample->rate).totalNumberOfFrames() * getChannels();
+		if (pos > _sample->data.size())
+			return false;
+		_pos = pos;
+		return true;
+	}
+
+private:
+	uint getChannels() const { return _sample->isStereo ? 2 : 1; }
+
+	Common::SharedPtr<const CachedSample> _sample;
+	uint32 _pos;
+};
+
+/**
+ * Decode a stream completely, unless it turns out to have more than
+ * maxSamples samples.
+ */
+static CachedSample *decodeSample(SeekableAudioStream *stream, uint32 maxSamples) {
+	const uint channels = stream->isStereo() ? 2 : 1;
+
+	// Skip long samples without decoding them when their length is known
+	const uint32 frames = stream->getLength().convertToFramerate(stream->getRate()).totalNumberOfFrames();
+	if (frames > maxSamples / channels)
+		return nullptr;
+
+	CachedSample *sample = new CachedSample();
+	sample->rate = stream->getRate();
+	sample->isStereo = stream->isStereo();
+	uint32 capacity = frames * channels;
+	sample->data.reserve(capacity);
+
+	int16 buffer[2048];
+	while (!stream->endOfData()) {
+		const int count = stream->readBuffer(buffer, ARRAYSIZE(buffer));
+		if (count <= 0)
+			break;
+
+		const uint32 size = sample->data.size();
+		if (size + count > maxSamples) {
+			delete sample;
+			return nullptr;
+		}
+		// The length of some streams is not known beforehand, so grow the
+		// buffer geometrically to avoid copying it for every chunk
+		if (size + count > capacity) {
+			capacity = MIN(MAX<uint32>(size * 2, size + count), maxSamples);
+			sample->data.reserve(capacity);
+		}
+		sample->data.resize(size + count);
+		memcpy(&sample->data[size], buffer, count * sizeof(int16));
+	}
+
+	return sample;
+}
+
+SampleCache::SampleCache() : _memoryBudget(kDefaultMemoryBudget), _memoryUsage(0), _stamp(0) {
+}
+
+SeekableAudioStream *SampleCache::getStream(const Common::String &key) {
+	Common::StackLock lock(_mutex);
+
+	EntryMap::iterator entry = _entries.find(key);
+	if (entry == _entries.end())
+		return nullptr;
+
+	entry->_value.lastUsed = ++_stamp;
+	return new CachedSampleStream(entry->_value.sample);
+}
+
+SeekableAudioStream *SampleCache::addStream(const Common::String &key, SeekableAudioStream *stream) {
+	if (!stream)
+		return nullptr;
+
+	const uint32 maxSize = _memoryBudget / kMaxSampleFraction;
+	CachedSample *sample = decodeSample(stream, maxSize / sizeof(int16));
+	if (!sample) {
+		debug(5, "SampleCache: Not caching sample '%s'", key.c_str());
+		stream->rewind();
+		return stream;
+	}
+	delete stream;
+
+	Common::StackLock lock(_mutex);
+
+	EntryMap::iterator entry = _entries.find(key);
+	if (entry != _entries.end()) {
+		_memoryUsage -= entry->_value.sample->getSize();
+		_entries.erase(entry);
+	}
+
+	trim(_memoryBudget - sample->getSize());
+
+	Entry &newEntry = _entries[key];
+	newEntry.sample = Common::SharedPtr<const CachedSample>(sample);
+	newEntry.lastUsed = ++_stamp;
+	_memoryUsage += sample->getSize();
+
+	return new CachedSampleStream(newEntry.sample);
+}
+
+void SampleCache::clear() {
+	Common::StackLock lock(_mutex);
+
+	_entries.clear();
+	_memoryUsage = 0;
+}
+
+void SampleCache::setMemoryBudget(uint32 bytes) {
+	Common::StackLock lock(_mutex);
+
+	_memoryBudget = bytes;
+	trim(_memoryBudget);
+}
+
+void SampleCache::trim(uint32 budget) {
+	// Evict the least recently used samples until the others fit
+	while (_memoryUsage > budget && !_entries.empty()) {
+		EntryMap::iterator oldest = _entries.begin();
+		for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+			if (i->_value.lastUsed < oldest->_value.lastUsed)
+				oldest = i;
+		}
+
+		_memoryUsage -= oldest->_value.sample->getSize();
+		_entries.erase(oldest);
+	}
+}
+
+/**
+ * Return a stream playing the sample if it is cached, and dispose of the
+ * compressed stream then.
+ */
+static SeekableAudioStream *getCachedStream(const Common::String &key, Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse) {
+	SeekableAudioStream *cached = SampleCache::instance().getStream(key);
+	if (cached && disposeAfterUse == DisposeAfterUse::YES)
+		delete stream;
+	return cached;
+}
+
+SeekableAudioStream *makeCachedStream(const Common::String &key, Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, SeekableAudioStreamFactory factory) {
+	SeekableAudioStream *cached = getCachedStream(key, stream, disposeAfterUse);
+	if (cached)
+		return cached;
+
+	return SampleCache::instance().addStream(key, factory(stream, disposeAfterUse));
+}
+
+SeekableAudioStream *makeCachedADPCMStream(const Common::String &key, Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse,
+                                           uint32 size, ADPCMType type, int rate, int channels, uint32 blockAlign) {
+	SeekableAudioStream *cached = getCachedStream(key, stream, disposeAfterUse);
+	if (cached)
+		return cached;
+
+	return SampleCache::instance().addStream(key, makeADPCMStream(stream, disposeAfterUse, size, type, rate, channels, blockAlign));
+}
+
+} // End of namespace Audio
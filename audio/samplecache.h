@@ -0,0 +1,156 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_SAMPLECACHE_H
+#define AUDIO_SAMPLECACHE_H
+
+#include "audio/decoders/adpcm.h"
+
+#include "common/hash-str.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
+#include "common/singleton.h"
+#include "common/str.h"
+#include "common/types.h"
+
+namespace Common {
+class SeekableReadStream;
+}
+
+namespace Audio {
+
+/**
+ * @defgroup audio_samplecache Sample cache
+ * @ingroup audio
+ *
+ * @brief Cache of fully decoded sound samples.
+ * @{
+ */
+
+class SeekableAudioStream;
+struct CachedSample;
+
+/**
+ * Signature of the factories creating an audio stream from a compressed
+ * file, such as makeMP3Stream, makeVorbisStream or makeFLACStream.
+ */
+typedef SeekableAudioStream *(*SeekableAudioStreamFactory)(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse);
+
+/**
+ * Cache of short sound samples, which are decoded to PCM only once instead
+ * of every time they are played.
+ *
+ * Samples are identified by a key chosen by the engine, usually the name
+ * of the file they come from. The cache keeps its decoded samples within a
+ * memory budget and evicts the least recently used ones first. It is
+ * cleared when an engine exits.
+ *
+ * The streams handed out by the cache all share the decoded data, so a
+ * sample can be played several times at once, and it stays valid as long
+ * as one of its streams is alive even if it is evicted meanwhile.
+ */
+class SampleCache : public Common::Singleton<SampleCache> {
+public:
+	/**
+	 * Get a new stream playing a cached sample.
+	 *
+	 * @param key  Key of the sample.
+	 *
+	 * @return  A stream the caller has to delete, or nullptr if the sample
+	 *          is not cached.
+	 */
+	SeekableAudioStream *getStream(const Common::String &key);
+
+	/**
+	 * Decode a sample and add it to the cache.
+	 *
+	 * Samples too large for the cache are not decoded.
+	 *
+	 * @param key     Key of the sample.
+	 * @param stream  Stream of the sample, may be nullptr. The cache takes
+	 *                ownership of it.
+	 *
+	 * @return  A stream playing the cached sample, or the given stream,
+	 *          rewound, if the sample could not be cached.
+	 */
+	SeekableAudioStream *addStream(const Common::String &key, SeekableAudioStream *stream);
+
+	/** Remove all samples from the cache. */
+	void clear();
+
+	/** Set the memory the decoded samples may use, in bytes. */
+	void setMemoryBudget(uint32 bytes);
+
+	/** Get the memory the decoded samples may use, in bytes. */
+	uint32 getMemoryBudget() const { return _memoryBudget; }
+
+	/** Get the memory used by the decoded samples, in bytes. */
+	uint32 getMemoryUsage() const { return _memoryUsage; }
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	SampleCache();
+
+	struct Entry {
+		Common::SharedPtr<const CachedSample> sample;
+		uint32 lastUsed;
+	};
+
+	typedef Common::HashMap<Common::String, Entry> EntryMap;
+
+	void trim(uint32 budget);
+
+	Common::Mutex _mutex;
+	EntryMap _entries;
+	uint32 _memoryBudget;
+	uint32 _memoryUsage;
+	uint32 _stamp;
+};
+
+/**
+ * Create an audio stream for a sample through the sample cache.
+ *
+ * If the sample is cached already, the stream is disposed of and a stream
+ * playing the cached sample is returned. Otherwise, the stream is decoded
+ * with the given factory and added to the cache.
+ *
+ * @param key              Key of the sample, e.g. its file name.
+ * @param stream           Stream of the compressed sample.
+ * @param disposeAfterUse  Whether to delete the stream after use.
+ * @param factory          Factory decoding the stream, e.g. makeVorbisStream.
+ *
+ * @return  A new SeekableAudioStream, or nullptr if the stream could not
+ *          be decoded.
+ */
+SeekableAudioStream *makeCachedStream(const Common::String &key, Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, SeekableAudioStreamFactory factory);
+
+/**
+ * Variant of makeCachedStream for makeADPCMStream, whose parameters are
+ * described there.
+ */
+SeekableAudioStream *makeCachedADPCMStream(const Common::String &key, Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse,
+                                           uint32 size, ADPCMType type, int rate, int channels, uint32 blockAlign = 0);
+
+/** @} */
+
+} // End of namespace Audio
+
+#endif
@@ -0,0 +1,120 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "backends/imgui/imgui.h"
+#include "common/algorithm.h"
+#include "common/file.h"
+#include "common/profiler.h"
+
+#include "backends/imgui/components/imgui_profiler.h"
+
+namespace ImGuiEx {
+
+#ifdef ENABLE_PROFILER
+
+static bool zoneTimeGreater(const Common::Profiler::ZoneStats &a, const Common::Profiler::ZoneStats &b) {
+	return a.micros > b.micros;
+}
+
+void drawProfiler(const char *title, bool *p_open) {
+	if (!*p_open)
+		return;
+
+	ImGui::SetNextWindowSize(ImVec2(480, 420), ImGuiCond_FirstUseEver);
+	if (!ImGui::Begin(title, p_open)) {
+		ImGui::End();
+		return;
+	}
+
+	Common::Profiler &profiler = Common::Profiler::instance();
+
+	Common::Array<float> frameTimes;
+	profiler.getFrameTimes(frameTimes);
+	if (!frameTimes.empty()) {
+		float maxTime = 0.f;
+		float totalTime = 0.f;
+		for (uint i = 0; i < frameTimes.size(); i++) {
+			maxTime = MAX(maxTime, frameTimes[i]);
+			totalTime += frameTimes[i];
+		}
+		ImGui::Text("Frame: %.2f ms, average %.2f ms, max %.2f ms", frameTimes.back(), totalTime / frameTimes.size(), maxTime);
+		ImGui::PlotLines("##frames", frameTimes.data(), frameTimes.size(), 0, nullptr, 0.f, maxTime, ImVec2(-1, 80));
+	}
+
+	if (profiler.isCapturing()) {
+		if (ImGui::Button("Stop capture"))
+			profiler.stopCapture();
+		ImGui::SameLine();
+		ImGui::Text("%u zones captured", profiler.getCapturedCount());
+	} else {
+		if (ImGui::Button("Start capture"))
+			profiler.startCapture();
+		if (profiler.getCapturedCount()) {
+			ImGui::SameLine();
+			if (ImGui::Button("Save trace")) {
+				Common::DumpFile file;
+				if (file.open(Common::Path("scummvm-trace.json")))
+					profiler.exportChromeTrace(file);
+			}
+			ImGui::SetItemTooltip("Save the capture to scummvm-trace.json,\nfor chrome://tracing or ui.perfetto.dev");
+		}
+	}
+
+	Common::Array<Common::Profiler::ZoneStats> zones;
+	profiler.getLastFrameZones(zones);
+	Common::sort(zones.begin(), zones.end(), zoneTimeGreater);
+
+	if (ImGui::BeginTable("Zones", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY)) {
+		ImGui::TableSetupColumn("Zone");
+		ImGui::TableSetupColumn("Calls", ImGuiTableColumnFlags_WidthFixed);
+		ImGui::TableSetupColumn("ms", ImGuiTableColumnFlags_WidthFixed);
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableHeadersRow();
+
+		for (uint i = 0; i < zones.size(); i++) {
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(zones[i].name);
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", zones[i].calls);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", zones[i].micros / 1000.f);
+		}
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+}
+
+#else
+
+void drawProfiler(const char *title, bool *p_open) {
+	if (!*p_open)
+		return;
+
+	if (ImGui::Begin(title, p_open))
+		ImGui::TextUnformatted("ScummVM was built without --enable-profiler");
+	ImGui::End();
+}
+
+#endif // ENABLE_PROFILER
+
+} // namespace ImGuiEx
@@ -36,7 +36,10 @@
 #include "common/fs.h"
 #include "common/archive.h"
 #include "common/config-manager.h"
+#include "common/crc.h"
 #include "common/compression/deflate.h"
+#include "common/compression/fastlz.h"
+#include "common/memstream.h"
 
 #include <errno.h>	// for removeSavefile()
 
@@ -44,13 +47,18 @@
 const char *const DefaultSaveFileManager::TIMESTAMPS_FILENAME = "timestamps";
 #endif
 
-DefaultSaveFileManager::DefaultSaveFileManager() {
+DefaultSaveFileManager::DefaultSaveFileManager() : _backgroundLastPoll(0) {
 }
 
-DefaultSaveFileManager::DefaultSaveFileManager(const Common::Path &defaultSavepath) {
+DefaultSaveFileManager::DefaultSaveFileManager(const Common::Path &defaultSavepath) : _backgroundLastPoll(0) {
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
+DefaultSaveFileManager::~DefaultSaveFileManager() {
+	finishBackgroundSaves();
+	flushCachedMetaInfo();
+}
+
 
 void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 	clearError();
@@ -72,6 +80,9 @@ void DefaultSaveFileManager::updateSavefilesList(Common::StringArray &lockedFile
 }
 
 Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &pattern) {
+	// Saves written in the background must be listed
+	finishBackgroundSaves();
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -92,6 +103,8 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &filename) {
+	finishBackgroundSave(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -108,6 +121,8 @@ Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &fi
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String &filename) {
+	finishBackgroundSave(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -125,11 +140,16 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 	} else {
 		// Open the file for loading.
 		Common::SeekableReadStream *sf = file->_value.createReadStream();
+		Common::SeekableReadStream *lz = Common::wrapFastLZReadStream(sf);
+		if (lz != sf)
+			return lz;
 		return Common::wrapCompressedReadStream(sf);
 	}
 }
 
 Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+	finishBackgroundSave(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	const Common::Path savePathName = getSavePath();
 	assureCached(savePathName);
@@ -165,15 +185,26 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 	Common::SeekableWriteStream *const sf = fileNode.createWriteStream();
 	if (!sf)
 		return nullptr;
-	Common::OutSaveFile *const result = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf);
+	Common::WriteStream *stream = sf;
+	if (compress) {
+		// The game domain may override this, for games with large saves
+		if (ConfMan.get("save_compression") == "fast")
+			stream = Common::wrapFastLZWriteStream(sf);
+		else
+			stream = Common::wrapCompressedWriteStream(sf);
+	}
+	Common::OutSaveFile *const result = new Common::OutSaveFile(stream);
 
 	// Add file to cache now that it exists.
 	_saveFileCache[filename] = Common::FSNode(fileNode.getPath());
+	invalidateMetaInfo(filename);
 
 	return result;
 }
 
 bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
+	finishBackgroundSave(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -198,6 +229,7 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 		// Remove from cache, this invalidates the 'file' iterator.
 		_saveFileCache.erase(file);
 		file = _saveFileCache.end();
+		invalidateMetaInfo(filename);
 
 		Common::ErrorCode result = removeFile(fileNode);
 		if (result == Common::kNoError)
@@ -233,6 +265,289 @@ bool DefaultSaveFileManager::exists(const Common::String &filename) {
 	return _saveFileCache.contains(filename);
 }
 
+#define SAVEINDEX_DIRECTORY ".saveindex"
+#define SAVEINDEX_TAG MKTAG('S','V','I','X')
+#define SAVEINDEX_VERSION 2
+
+bool DefaultSaveFileManager::getCachedMetaInfo(const Common::String &index, const Common::String &filename, Common::Array<byte> &data) {
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError)
+		return false;
+
+	MetaInfoIndex &metaIndex = loadMetaInfoIndex(index);
+	MetaInfoEntries::iterator entry = metaIndex.entries.find(filename);
+	if (entry == metaIndex.entries.end())
+		return false;
+
+	if (!entry->_value.verified) {
+		uint32 fileSize, checksum;
+		if (!getMetaInfoStamp(filename, fileSize, checksum) || fileSize != entry->_value.fileSize ||
+			checksum != entry->_value.checksum) {
+			// The save was replaced outside of ScummVM, or while the index
+			// was not loaded
+			metaIndex.entries.erase(entry);
+			metaIndex.dirty = true;
+			return false;
+		}
+		entry->_value.verified = true;
+	}
+
+	data = entry->_value.data;
+	return true;
+}
+
+void DefaultSaveFileManager::setCachedMetaInfo(const Common::String &index, const Common::String &filename, const Common::Array<byte> &data) {
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError)
+		return;
+
+	MetaInfoEntry entry;
+	if (!getMetaInfoStamp(filename, entry.fileSize, entry.checksum))
+		return;
+	entry.verified = true;
+	entry.data = data;
+
+	MetaInfoIndex &metaIndex = loadMetaInfoIndex(index);
+	metaIndex.entries[filename] = entry;
+	metaIndex.dirty = true;
+}
+
+void DefaultSaveFileManager::flushCachedMetaInfo() {
+	for (auto &metaIndex : _metaInfoIndexes) {
+		if (metaIndex._value.dirty)
+			saveMetaInfoIndex(metaIndex._key, metaIndex._value);
+	}
+}
+
+DefaultSaveFileManager::MetaInfoIndex &DefaultSaveFileManager::loadMetaInfoIndex(const Common::String &index) {
+	Common::HashMap<Common::String, MetaInfoIndex>::iterator it = _metaInfoIndexes.find(index);
+	if (it != _metaInfoIndexes.end())
+		return it->_value;
+
+	MetaInfoIndex &metaIndex = _metaInfoIndexes[index];
+	metaIndex.directory = _cachedDirectory;
+
+	const Common::FSNode indexNode = Common::FSNode(_cachedDirectory).getChild(SAVEINDEX_DIRECTORY).getChild(index + ".idx");
+	Common::ScopedPtr<Common::SeekableReadStream> in(indexNode.createReadStream());
+	if (!in)
+		return metaIndex;
+
+	if (in->readUint32BE() != SAVEINDEX_TAG || in->readByte() != SAVEINDEX_VERSION) {
+		warning("DefaultSaveFileManager: Ignoring invalid save index '%s'", index.c_str());
+		return metaIndex;
+	}
+
+	const uint32 count = in->readUint32LE();
+	for (uint32 i = 0; i < count && !in->eos() && !in->err(); i++) {
+		const Common::String filename = in->readPascalString(false);
+		MetaInfoEntry entry;
+		entry.fileSize = in->readUint32LE();
+		entry.checksum = in->readUint32LE();
+		const uint32 dataSize = in->readUint32LE();
+		if (dataSize > in->size() - in->pos())
+			break;
+		entry.data.resize(dataSize);
+		in->read(entry.data.data(), dataSize);
+		metaIndex.entries[filename] = entry;
+	}
+
+	return metaIndex;
+}
+
+void DefaultSaveFileManager::saveMetaInfoIndex(const Common::String &index, MetaInfoIndex &metaIndex) {
+	metaIndex.dirty = false;
+
+	Common::FSNode indexDir = Common::FSNode(metaIndex.directory).getChild(SAVEINDEX_DIRECTORY);
+	if (!indexDir.exists() && !indexDir.createDirectory()) {
+		warning("DefaultSaveFileManager: Failed to create save index directory '%s'", indexDir.getPath().toString(Common::Path::kNativeSeparator).c_str());
+		return;
+	}
+
+	Common::ScopedPtr<Common::SeekableWriteStream> out(indexDir.getChild(index + ".idx").createWriteStream());
+	if (!out) {
+		warning("DefaultSaveFileManager: Failed to write save index '%s'", index.c_str());
+		return;
+	}
+
+	out->writeUint32BE(SAVEINDEX_TAG);
+	out->writeByte(SAVEINDEX_VERSION);
+	out->writeUint32LE(metaIndex.entries.size());
+	for (const auto &entry : metaIndex.entries) {
+		// Longer names are rejected by getMetaInfoStamp()
+		out->writeByte(entry._key.size());
+		out->writeString(entry._key);
+		out->writeUint32LE(entry._value.fileSize);
+		out->writeUint32LE(entry._value.checksum);
+		out->writeUint32LE(entry._value.data.size());
+		out->write(entry._value.data.data(), entry._value.data.size());
+	}
+	out->finalize();
+}
+
+bool DefaultSaveFileManager::getMetaInfoStamp(const Common::String &filename, uint32 &fileSize, uint32 &checksum) {
+	if (filename.size() > 255)
+		return false;
+
+	finishBackgroundSave(filename);
+
+	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
+	if (file == _saveFileCache.end())
+		return false;
+
+	Common::ScopedPtr<Common::SeekableReadStream> in(file->_value.createReadStream());
+	if (!in)
+		return false;
+
+	fileSize = in->size();
+	uint32 start = fileSize > 8 ? fileSize - 8 : 0;
+
+	// The trailer of compressed saves holds the CRC of all their contents,
+	// while uncompressed ones are checked from their extended header on,
+	// since it holds all the metadata which is cached
+	const uint32 magic = in->readUint32BE();
+	if ((magic >> 16) != 0x1F8B && magic != MKTAG('S','V','L','Z') && fileSize > 8) {
+		in->seek(fileSize - 4);
+		const uint32 headerOffset = in->readUint32LE();
+		if (headerOffset > 0 && headerOffset < fileSize - 4)
+			start = headerOffset;
+	}
+
+	Common::Array<byte> stampData;
+	stampData.resize(fileSize - start);
+	in->seek(start);
+	if (in->read(stampData.data(), stampData.size()) != stampData.size())
+		return false;
+
+	checksum = Common::CRC32().crcFast(stampData.data(), stampData.size());
+	return true;
+}
+
+void DefaultSaveFileManager::invalidateMetaInfo(const Common::String &filename) {
+	for (auto &metaIndex : _metaInfoIndexes) {
+		if (metaIndex._value.entries.contains(filename)) {
+			metaIndex._value.entries.erase(filename);
+			metaIndex._value.dirty = true;
+		}
+	}
+}
+
+// Background saves are compressed from pollBackgroundSaves() at most every
+// BACKGROUND_SAVE_INTERVAL ms, for BACKGROUND_SAVE_BUDGET ms each time. This
+// takes at most a fifth of the time of the main loop, and leaves most of a
+// 60 fps frame to the engine. The clock is checked after each chunk of
+// BACKGROUND_SAVE_CHUNK_SIZE bytes, which takes well under a millisecond to
+// deflate on slow targets.
+#define BACKGROUND_SAVE_INTERVAL 10
+#define BACKGROUND_SAVE_BUDGET 2
+#define BACKGROUND_SAVE_CHUNK_SIZE 8192
+
+bool DefaultSaveFileManager::saveInBackground(const Common::String &filename, Common::MemoryWriteStreamDynamic *data, bool compress) {
+	// An earlier save of the same file must not replace this one later
+	finishBackgroundSave(filename);
+
+	// Check right away that the file can be written
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError) {
+		delete data;
+		return false;
+	}
+	for (const auto &lockedFile : _lockedFiles) {
+		if (filename == lockedFile) {
+			delete data;
+			return false;
+		}
+	}
+
+	BackgroundSave save;
+	save.filename = filename;
+	save.data = data;
+	// The packer owns the stream object
+	save.packed = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+	save.packer = save.packed;
+	if (compress) {
+		// The game domain may override this, for games with large saves
+		if (ConfMan.get("save_compression") == "fast")
+			save.packer = Common::wrapFastLZWriteStream(save.packed);
+		else
+			save.packer = Common::wrapCompressedWriteStream(save.packed);
+	}
+	save.written = 0;
+	_backgroundSaves.push_back(save);
+
+	return true;
+}
+
+bool DefaultSaveFileManager::isSavingInBackground(const Common::String &filename) {
+	for (const auto &save : _backgroundSaves) {
+		if (save.filename.equalsIgnoreCase(filename))
+			return true;
+	}
+	return false;
+}
+
+void DefaultSaveFileManager::finishBackgroundSaves() {
+	finishBackgroundSave(Common::String());
+}
+
+void DefaultSaveFileManager::pollBackgroundSaves() {
+	if (_backgroundSaves.empty())
+		return;
+
+	const uint32 start = g_system->getMillis();
+	if (start - _backgroundLastPoll < BACKGROUND_SAVE_INTERVAL)
+		return;
+	_backgroundLastPoll = start;
+
+	do {
+		if (packBackgroundSave(_backgroundSaves.front(), BACKGROUND_SAVE_CHUNK_SIZE)) {
+			BackgroundSave save = _backgroundSaves.front();
+			_backgroundSaves.remove_at(0);
+			writeBackgroundSave(save);
+		}
+	} while (!_backgroundSaves.empty() && g_system->getMillis() - start < BACKGROUND_SAVE_BUDGET);
+}
+
+bool DefaultSaveFileManager::packBackgroundSave(BackgroundSave &save, uint32 budget) {
+	const uint32 count = MIN<uint32>(budget, save.data->size() - save.written);
+	save.packer->write(save.data->getData() + save.written, count);
+	save.written += count;
+	return save.written >= save.data->size();
+}
+
+void DefaultSaveFileManager::finishBackgroundSave(const Common::String &filename) {
+	for (uint i = 0; i < _backgroundSaves.size(); i++) {
+		if (filename.empty() || _backgroundSaves[i].filename.equalsIgnoreCase(filename)) {
+			packBackgroundSave(_backgroundSaves[i], 0xFFFFFFFF);
+			BackgroundSave save = _backgroundSaves[i];
+			_backgroundSaves.remove_at(i--);
+			writeBackgroundSave(save);
+		}
+	}
+}
+
+// The save must already be removed from the queue, because openForSaving()
+// finishes the pending saves of the same file
+void DefaultSaveFileManager::writeBackgroundSave(BackgroundSave &save) {
+	save.packer->finalize();
+	bool failed = save.packer->err();
+
+	// The packed data is written in one go. Where the file system supports
+	// it, the new file then atomically replaces the old one when it is
+	// closed.
+	Common::OutSaveFile *file = failed ? nullptr : openForSaving(save.filename, false);
+	if (file) {
+		file->write(save.packed->getData(), save.packed->size());
+		file->finalize();
+		failed = file->err();
+		delete file;
+	}
+	if (!file || failed)
+		warning("DefaultSaveFileManager: Failed to write '%s' in the background", save.filename.c_str());
+
+	delete save.packer;
+	delete save.data;
+}
+
 Common::Path DefaultSaveFileManager::getSavePath() const {
 
 	Common::Path dir;
@@ -265,6 +580,11 @@ void DefaultSaveFileManager::assureCached(const Common::Path &savePathName) {
 		return;
 	}
 
+	// The indexes belong to the previous directory, they are reloaded
+	// when needed so that files changed meanwhile are noticed.
+	flushCachedMetaInfo();
+	_metaInfoIndexes.clear();
+
 	_saveFileCache.clear();
 	_cachedDirectory.clear();
 
@@ -35,6 +35,7 @@ class DefaultSaveFileManager : public Common::SaveFileManager {
 public:
 	DefaultSaveFileManager();
 	DefaultSaveFileManager(const Common::Path &defaultSavepath);
+	~DefaultSaveFileManager() override;
 
 	void updateSavefilesList(Common::StringArray &lockedFiles) override;
 	Common::StringArray listSavefiles(const Common::String &pattern) override;
@@ -44,6 +45,15 @@ public:
 	bool removeSavefile(const Common::String &filename) override;
 	bool exists(const Common::String &filename) override;
 
+	bool getCachedMetaInfo(const Common::String &index, const Common::String &filename, Common::Array<byte> &data) override;
+	void setCachedMetaInfo(const Common::String &index, const Common::String &filename, const Common::Array<byte> &data) override;
+	void flushCachedMetaInfo() override;
+
+	bool saveInBackground(const Common::String &filename, Common::MemoryWriteStreamDynamic *data, bool compress = true) override;
+	bool isSavingInBackground(const Common::String &filename) override;
+	void finishBackgroundSaves() override;
+	void pollBackgroundSaves() override;
+
 #ifdef USE_LIBCURL
 
 	static const uint32 INVALID_TIMESTAMP = UINT_MAX;
@@ -99,6 +109,67 @@ protected:
 	 */
 	Common::StringArray _lockedFiles;
 
+	/**
+	 * Metadata of a save file, along with the size and checksum of the file
+	 * when it was cached. For compressed saves, the checksum covers the
+	 * gzip or fast LZ trailer, which holds the CRC of the whole contents.
+	 * For uncompressed saves, it covers the extended header.
+	 *
+	 * The checksum is only compared the first time an entry is used after
+	 * its index was loaded, as changes made through this manager drop the
+	 * entry anyway.
+	 */
+	struct MetaInfoEntry {
+		uint32 fileSize;
+		uint32 checksum;
+		bool verified;
+		Common::Array<byte> data;
+
+		MetaInfoEntry() : fileSize(0), checksum(0), verified(false) {}
+	};
+
+	typedef Common::HashMap<Common::String, MetaInfoEntry, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> MetaInfoEntries;
+
+	struct MetaInfoIndex {
+		Common::Path directory;
+		MetaInfoEntries entries;
+		bool dirty;
+
+		MetaInfoIndex() : dirty(false) {}
+	};
+
+	/**
+	 * Metadata indexes of the currently cached directory. They are stored
+	 * in its ".saveindex" subdirectory, one file per index.
+	 */
+	Common::HashMap<Common::String, MetaInfoIndex> _metaInfoIndexes;
+
+	MetaInfoIndex &loadMetaInfoIndex(const Common::String &index);
+	void saveMetaInfoIndex(const Common::String &index, MetaInfoIndex &metaIndex);
+	bool getMetaInfoStamp(const Common::String &filename, uint32 &fileSize, uint32 &checksum);
+	void invalidateMetaInfo(const Common::String &filename);
+
+	/**
+	 * A save being compressed from pollBackgroundSaves(). The save file is
+	 * only written once all of it has been compressed in memory, so that
+	 * the previous file stays intact until then.
+	 */
+	struct BackgroundSave {
+		Common::String filename;
+		Common::MemoryWriteStreamDynamic *data;
+		Common::WriteStream *packer;
+		Common::MemoryWriteStreamDynamic *packed;
+		uint32 written;
+	};
+
+	/** Saves queued by saveInBackground(), in the order they are compressed. */
+	Common::Array<BackgroundSave> _backgroundSaves;
+	uint32 _backgroundLastPoll;
+
+	bool packBackgroundSave(BackgroundSave &save, uint32 budget);
+	void finishBackgroundSave(const Common::String &filename);
+	void writeBackgroundSave(BackgroundSave &save);
+
 private:
 	/**
 	 * The currently cached directory.
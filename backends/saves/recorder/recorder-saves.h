@@ -30,6 +30,9 @@
 class RecorderSaveFileManager : public DefaultSaveFileManager {
 	virtual Common::StringArray listSaveFiles(const Common::String &pattern);
 	virtual Common::InSaveFile *openForLoading(const Common::String &filename);
+	// The saves come from the recording, so they bypass the metadata index
+	bool getCachedMetaInfo(const Common::String &index, const Common::String &filename, Common::Array<byte> &data) override { return false; }
+	void setCachedMetaInfo(const Common::String &index, const Common::String &filename, const Common::Array<byte> &data) override {}
 };
 
 #endif
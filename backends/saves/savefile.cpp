@@ -20,6 +20,7 @@
  */
 
 #include "common/util.h"
+#include "common/memstream.h"
 #include "common/savefile.h"
 #include "common/str.h"
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
@@ -124,6 +125,19 @@ bool SaveFileManager::renameSavefile(const String &oldFilename, const String &ne
 	return removeSavefile(oldFilename);
 }
 
+bool SaveFileManager::saveInBackground(const String &name, MemoryWriteStreamDynamic *data, bool compress) {
+	OutSaveFile *outFile = openForSaving(name, compress);
+	if (outFile) {
+		outFile->write(data->getData(), data->size());
+		outFile->finalize();
+	}
+
+	bool success = outFile && !outFile->err();
+	delete outFile;
+	delete data;
+	return success;
+}
+
 String SaveFileManager::popErrorDesc() {
 	String err = _errorDesc;
 	clearError();
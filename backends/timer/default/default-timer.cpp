@@ -23,6 +23,11 @@
 #include "backends/timer/default/default-timer.h"
 #include "common/util.h"
 #include "common/system.h"
+#include "common/debug.h"
+
+#ifdef ENABLE_EVENTRECORDER
+#include "gui/EventRecorder.h"
+#endif
 
 struct TimerSlot {
 	Common::TimerManager::TimerProc callback;
@@ -30,87 +35,107 @@ struct TimerSlot {
 	Common::String id;
 	uint32 interval;	// in microseconds
 
-	uint32 nextFireTime;	// in milliseconds
-	uint32 nextFireTimeMicro;	// microseconds part of nextFire
-
-	TimerSlot *next;
-
-	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), nextFireTimeMicro(0), next(nullptr) {}
-};
+	uint64 nextFireTime;	// in microseconds
+	uint64 sequence;	// keeps timers due at the same time in scheduling order
 
-void insertPrioQueue(TimerSlot *head, TimerSlot *newSlot) {
-	// The head points to a fake anchor TimerSlot; this common
-	// trick allows us to get rid of many special cases.
+	DefaultTimerManager::TimerStats stats;
 
-	const uint32 nextFireTime = newSlot->nextFireTime;
-	TimerSlot *slot = head;
-	newSlot->next = nullptr;
+	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), sequence(0) {}
 
-	// Insert the new slot into the sorted list of already scheduled
-	// timers in such a way that the list stays sorted...
-	while (true) {
-		assert(slot);
-		if (slot->next == nullptr || nextFireTime < slot->next->nextFireTime) {
-			newSlot->next = slot->next;
-			slot->next = newSlot;
-			return;
-		}
-		slot = slot->next;
+	bool firesBefore(const TimerSlot *other) const {
+		if (nextFireTime != other->nextFireTime)
+			return nextFireTime < other->nextFireTime;
+		return sequence < other->sequence;
 	}
-}
+};
 
 
 DefaultTimerManager::DefaultTimerManager() :
 	_timerCallbackNext(0),
-	_head(nullptr) {
-
-	_head = new TimerSlot();
+	_nextSequence(0) {
 }
 
 DefaultTimerManager::~DefaultTimerManager() {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-	while (slot) {
-		TimerSlot *next = slot->next;
-		delete slot;
-		slot = next;
+	for (uint i = 0; i < _queue.size(); ++i)
+		delete _queue[i];
+	_queue.clear();
+}
+
+uint64 DefaultTimerManager::getCurrentMicros() const {
+#ifdef ENABLE_EVENTRECORDER
+	// Recordings are driven by the recorded millisecond clock, which the
+	// real microsecond counter would not follow.
+	if (g_eventRec.getRecordMode() != GUI::EventRecorder::kPassthrough)
+		return (uint64)g_system->getMillis(true) * 1000;
+#endif
+	return g_system->getMicros();
+}
+
+void DefaultTimerManager::schedule(TimerSlot *slot) {
+	slot->sequence = _nextSequence++;
+	_queue.push_back(slot);
+	siftUp(_queue.size() - 1);
+}
+
+void DefaultTimerManager::siftUp(uint index) {
+	TimerSlot *slot = _queue[index];
+	while (index > 0) {
+		const uint parent = (index - 1) / 2;
+		if (!slot->firesBefore(_queue[parent]))
+			break;
+		_queue[index] = _queue[parent];
+		index = parent;
 	}
-	_head = nullptr;
+	_queue[index] = slot;
+}
+
+void DefaultTimerManager::siftDown(uint index) {
+	const uint size = _queue.size();
+	TimerSlot *slot = _queue[index];
+	while (true) {
+		uint child = index * 2 + 1;
+		if (child >= size)
+			break;
+		if (child + 1 < size && _queue[child + 1]->firesBefore(_queue[child]))
+			++child;
+		if (!_queue[child]->firesBefore(slot))
+			break;
+		_queue[index] = _queue[child];
+		index = child;
+	}
+	_queue[index] = slot;
 }
 
 void DefaultTimerManager::handler() {
 	Common::StackLock lock(_mutex);
 
-	uint32 curTime = g_system->getMillis(true);
-
-	// On slow systems this could still be run after destructor
-	if (!_head)
-		return;
+	const uint64 curTime = getCurrentMicros();
 
 	// Repeat as long as there is a TimerSlot that is scheduled to fire.
-	TimerSlot *slot = _head->next;
-	while (slot && slot->nextFireTime < curTime) {
-		// Remove the slot from the priority queue
-		_head->next = slot->next;
-
-		// Update the fire time and reinsert the TimerSlot into the priority
-		// queue.
+	while (!_queue.empty() && _queue[0]->nextFireTime <= curTime) {
+		TimerSlot *slot = _queue[0];
+
+		// Keep track of how late the timer fires, which is where the
+		// jitter of the timer procs comes from.
+		const uint64 lateness = curTime - slot->nextFireTime;
+		slot->stats.fired++;
+		slot->stats.maxLateness = MAX<uint32>(slot->stats.maxLateness, (uint32)MIN<uint64>(lateness, 0xFFFFFFFF));
+		if (lateness >= slot->interval)
+			slot->stats.overruns++;
+
+		// Advance the fire time from the scheduled time rather than from the
+		// current one, so periodic timers do not drift, and move the slot
+		// to its new place in the queue.
 		assert(slot->interval > 0);
-		slot->nextFireTime += (slot->interval / 1000);
-		slot->nextFireTimeMicro += (slot->interval % 1000);
-		if (slot->nextFireTimeMicro > 1000) {
-			slot->nextFireTime += slot->nextFireTimeMicro / 1000;
-			slot->nextFireTimeMicro %= 1000;
-		}
-		insertPrioQueue(_head, slot);
+		slot->nextFireTime += slot->interval;
+		slot->sequence = _nextSequence++;
+		siftDown(0);
 
 		// Invoke the timer callback
 		assert(slot->callback);
 		slot->callback(slot->refCon);
-
-		// Look at the next scheduled timer
-		slot = _head->next;
 	}
 }
 
@@ -146,11 +171,9 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 	slot->refCon = refCon;
 	slot->id = id;
 	slot->interval = interval;
-	slot->nextFireTime = g_system->getMillis() + interval / 1000;
-	slot->nextFireTimeMicro = interval % 1000;
-	slot->next = nullptr;
+	slot->nextFireTime = getCurrentMicros() + interval;
 
-	insertPrioQueue(_head, slot);
+	schedule(slot);
 
 	return true;
 }
@@ -158,17 +181,22 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-
-	while (slot->next) {
-		if (slot->next->callback == callback) {
-			TimerSlot *next = slot->next->next;
-			delete slot->next;
-			slot->next = next;
+	uint size = 0;
+	for (uint i = 0; i < _queue.size(); ++i) {
+		TimerSlot *slot = _queue[i];
+		if (slot->callback == callback) {
+			if (slot->stats.overruns)
+				debug(2, "Timer '%s' overran %u of %u times, at most %u us late", slot->id.c_str(), slot->stats.overruns, slot->stats.fired, slot->stats.maxLateness);
+			delete slot;
 		} else {
-			slot = slot->next;
+			_queue[size++] = slot;
 		}
 	}
+	_queue.resize(size);
+
+	// Restore the heap order of the remaining timers
+	for (uint i = size / 2; i-- > 0;)
+		siftDown(i);
 
 	// We need to remove all names referencing the timer proc here.
 	//
@@ -187,3 +215,15 @@ void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 			_callbacks.erase(i);
 	}
 }
+
+bool DefaultTimerManager::getTimerStats(const Common::String &id, TimerStats &stats) {
+	Common::StackLock lock(_mutex);
+
+	for (uint i = 0; i < _queue.size(); ++i) {
+		if (_queue[i]->id.equalsIgnoreCase(id)) {
+			stats = _queue[i]->stats;
+			return true;
+		}
+	}
+	return false;
+}
@@ -22,6 +22,7 @@
 #ifndef BACKENDS_TIMER_DEFAULT_H
 #define BACKENDS_TIMER_DEFAULT_H
 
+#include "common/array.h"
 #include "common/str.h"
 #include "common/hash-str.h"
 #include "common/timer.h"
@@ -30,14 +31,33 @@
 struct TimerSlot;
 
 class DefaultTimerManager : public Common::TimerManager {
+public:
+	/**
+	 * Statistics about how punctually a timer proc has been invoked.
+	 */
+	struct TimerStats {
+		uint32 fired;       ///< Number of times the timer proc has been invoked.
+		uint32 overruns;    ///< Number of invocations which were late by at least one interval.
+		uint32 maxLateness; ///< Largest delay of an invocation, in microseconds.
+
+		TimerStats() : fired(0), overruns(0), maxLateness(0) {}
+	};
+
 private:
 	typedef Common::HashMap<Common::String, TimerProc, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TimerSlotMap;
 
 	Common::Mutex _mutex;
-	TimerSlot *_head;
+	/** Binary min-heap of the installed timers, ordered by their next fire time. */
+	Common::Array<TimerSlot *> _queue;
 	TimerSlotMap _callbacks;
 
 	uint32 _timerCallbackNext;
+	uint64 _nextSequence;
+
+	uint64 getCurrentMicros() const;
+	void schedule(TimerSlot *slot);
+	void siftUp(uint index);
+	void siftDown(uint index);
 
 public:
 	DefaultTimerManager();
@@ -55,6 +75,13 @@ public:
 	 * Should be called from pollEvents() on backends without threads.
 	 */
 	void checkTimers(uint32 interval = 10);
+
+	/**
+	 * Get the statistics of the timer proc installed with the given name.
+	 *
+	 * @return false if no such timer proc is installed.
+	 */
+	bool getTimerStats(const Common::String &id, TimerStats &stats);
 };
 
 #endif
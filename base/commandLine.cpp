@@ -199,8 +199,10 @@ static const char HELP_STRING4[] =
 	"                           atari, macintosh, macintoshbw, vgaGray)\n"
 #ifdef ENABLE_EVENTRECORDER
 	"  --record-mode=MODE       Specify record mode for event recorder (record, playback,\n"
-	"                           info, update, passthrough [default])\n"
+	"                           benchmark, info, update, passthrough [default])\n"
 	"  --record-file-name=FILE  Specify record file name\n"
+	"  --benchmark-output=FILE  Write the time of each frame of a benchmark playback\n"
+	"                           to FILE as CSV\n"
 	"  --disable-display        Disable any gfx output. Used for headless events\n"
 	"                           playback by Event Recorder\n"
 	"  --screenshot-period=NUM  When recording, trigger a screenshot every NUM milliseconds\n"
@@ -346,6 +348,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("dump_scripts", false);
 	ConfMan.registerDefault("save_slot", -1);
 	ConfMan.registerDefault("autosave_period", 5 * 60); // By default, trigger autosave every 5 minutes
+	ConfMan.registerDefault("save_compression", "deflate");
 	ConfMan.registerDefault("engine_speed", 60); // FPS limit for 3D games
 
 #if defined(ENABLE_SCUMM) || defined(ENABLE_SWORD2)
@@ -805,6 +808,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION("record-file-name")
 			END_OPTION
 
+			DO_LONG_OPTION("benchmark-output")
+			END_OPTION
+
 			DO_LONG_COMMAND("list-records")
 			END_COMMAND
 
@@ -59,6 +59,7 @@
 
 #include "audio/mididrv.h"
 #include "audio/musicplugin.h"  /* for music manager */
+#include "audio/samplecache.h"
 
 #include "graphics/cursorman.h"
 #include "graphics/fontman.h"
@@ -328,6 +329,9 @@ static Common::Error runGame(const Plugin *enginePlugin, OSystem &system, const
 	// Reset the file/directory mappings
 	SearchMan.clear();
 
+	// Drop the sound samples decoded for the game
+	Audio::SampleCache::instance().clear();
+
 #ifdef USE_TRANSLATION
 	TransMan.setLanguage(previousLanguage);
 	Common::TextToSpeechManager *ttsMan;
@@ -782,6 +786,8 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderUpdate);
 			} else if (recordMode == "playback") {
 				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderPlayback);
+			} else if (recordMode == "benchmark") {
+				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderPlayback, true);
 			} else if ((recordMode == "info") && (!recordFileName.empty())) {
 				Common::PlaybackFile record;
 				record.openRead(recordFileName);
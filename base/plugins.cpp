@@ -25,12 +25,15 @@
 #include "common/debug.h"
 #include "common/debug-channels.h"
 #include "common/config-manager.h"
+#include "common/file.h"
+#include "common/ptr.h"
 
 #ifdef DYNAMIC_MODULES
 #include "common/fs.h"
 #endif
 
 #include "base/detection/detection.h"
+#include "base/version.h"
 
 #include "engines/advancedDetector.h"
 
@@ -428,20 +431,41 @@ void PluginManagerUncached::updateConfigWithFileName(const Common::String &engin
 }
 
 #ifndef DETECTION_STATIC
+#define DETECTION_INDEX_TAG MKTAG('D','I','D','X')
+#define DETECTION_INDEX_VERSION 1
+
+/**
+ * The detection plugin is only loaded once it is queried. The launcher
+ * finds the descriptions of the games it lists in the detection index
+ * instead, so it does not need the detection plugin in memory.
+ **/
 void PluginManagerUncached::loadDetectionPlugin() {
 	if (_isDetectionLoaded) {
 		debug(9, "Detection plugin is already loaded. Adding each available engines to the memory.");
 		return;
 	}
 
+	// Unload all leftover engines before reloading the detection plugin.
+	// This is done here and not once it is queried, when an engine plugin
+	// may be in use.
+	unloadPluginsExcept(PLUGIN_TYPE_ENGINE, nullptr, false);
+
+	_isDetectionWanted = true;
+}
+
+const PluginList &PluginManagerUncached::getPlugins(PluginType t) {
+	if (t == PLUGIN_TYPE_ENGINE_DETECTION && _isDetectionWanted && !_isDetectionLoaded)
+		loadDetectionPluginNow();
+
+	return PluginManager::getPlugins(t);
+}
+
+void PluginManagerUncached::loadDetectionPluginNow() {
 	if (!_detectionPlugin) {
 		debug(9, "Detection plugin not found.");
 		return;
 	}
 
-	// Unload all leftover engines before reloading the detection plugin
-	unloadPluginsExcept(PLUGIN_TYPE_ENGINE, nullptr, false);
-
 	if (!_detectionPlugin->loadPlugin()) {
 		debug(9, "Detection plugin was not loaded correctly.");
 		return;
@@ -455,9 +479,18 @@ void PluginManagerUncached::loadDetectionPlugin() {
 	Common::for_each(pl.begin(), pl.end(), Common::bind1st(Common::mem_fun(&PluginManagerUncached::tryLoadPlugin), this));
 
 	_isDetectionLoaded = true;
+
+	// Now that the detection plugin is in memory, build the index
+	// if there is none yet for it
+	if (!_isDetectionIndexLoaded)
+		loadDetectionIndex();
+	if (_detectionIndex.empty())
+		saveDetectionIndex();
 }
 
 void PluginManagerUncached::unloadDetectionPlugin() {
+	_isDetectionWanted = false;
+
 	if (!_isDetectionLoaded) {
 		debug(9, "Detection plugin is already unloaded.");
 		return;
@@ -467,6 +500,145 @@ void PluginManagerUncached::unloadDetectionPlugin() {
 	_detectionPlugin->unloadPlugin();
 	_isDetectionLoaded = false;
 }
+
+bool PluginManagerUncached::findIndexedGame(const Common::String &engineId, const Common::String &gameId, Common::String &description) {
+	if (!_isDetectionIndexLoaded)
+		loadDetectionIndex();
+
+	if (_detectionIndex.empty())
+		return false;
+
+	description.clear();
+	Common::HashMap<Common::String, Common::StringMap>::const_iterator engine = _detectionIndex.find(engineId);
+	if (engine != _detectionIndex.end())
+		engine->_value.tryGetVal(gameId, description);
+
+	return true;
+}
+
+Common::Path PluginManagerUncached::getDetectionIndexPath() const {
+	if (!_detectionPlugin)
+		return Common::Path();
+
+	// The icons path is only set by default on some backends, the save
+	// path always has a default
+	Common::Path cacheDir = ConfMan.getPath("iconspath");
+	if (cacheDir.empty())
+		cacheDir = ConfMan.getPath("savepath");
+	if (cacheDir.empty())
+		return Common::Path();
+
+	return cacheDir.join("detection.idx");
+}
+
+/**
+ * The index is only valid for the detection plugin it was built from.
+ **/
+Common::String PluginManagerUncached::getDetectionIndexKey() const {
+	Common::FSNode node(_detectionPlugin->getFileName());
+	Common::ScopedPtr<Common::SeekableReadStream> stream(node.createReadStream());
+	if (!stream)
+		return Common::String();
+
+	return Common::String::format("%s|%s|%d", gScummVMFullVersion, _detectionPlugin->getFileName().toString().c_str(), (int)stream->size());
+}
+
+static Common::String readIndexString(Common::ReadStream &stream) {
+	const uint16 size = stream.readUint16LE();
+	return stream.readString(0, size);
+}
+
+static void writeIndexString(Common::WriteStream &stream, const Common::String &str) {
+	stream.writeUint16LE(str.size());
+	stream.writeString(str);
+}
+
+void PluginManagerUncached::loadDetectionIndex() {
+	const Common::Path path = getDetectionIndexPath();
+	if (path.empty())
+		return;
+
+	// Only try once, getDetectionIndexPath() needs the backend to be initialized
+	_isDetectionIndexLoaded = true;
+	_detectionIndex.clear();
+
+	Common::FSNode node(path);
+	if (!node.exists())
+		return;
+
+	Common::File in;
+	if (!in.open(node))
+		return;
+
+	if (in.readUint32BE() != DETECTION_INDEX_TAG || in.readUint32BE() != DETECTION_INDEX_VERSION)
+		return;
+
+	const Common::String key = getDetectionIndexKey();
+	if (key.empty() || readIndexString(in) != key) {
+		debug(9, "Detection index is out of date.");
+		return;
+	}
+
+	const uint32 engineCount = in.readUint32LE();
+	for (uint32 i = 0; i < engineCount && !in.eos(); i++) {
+		Common::StringMap &games = _detectionIndex[readIndexString(in)];
+		const uint32 gameCount = in.readUint32LE();
+		for (uint32 j = 0; j < gameCount && !in.eos(); j++) {
+			const Common::String gameId = readIndexString(in);
+			games[gameId] = readIndexString(in);
+		}
+	}
+
+	if (in.eos() || in.err()) {
+		warning("Corrupted detection index '%s'", path.toString(Common::Path::kNativeSeparator).c_str());
+		_detectionIndex.clear();
+		return;
+	}
+
+	debug(9, "Detection index loaded with %d engines.", _detectionIndex.size());
+}
+
+void PluginManagerUncached::saveDetectionIndex() {
+	const Common::Path path = getDetectionIndexPath();
+	if (path.empty())
+		return;
+
+	const Common::String key = getDetectionIndexKey();
+	if (key.empty())
+		return;
+
+	_detectionIndex.clear();
+	for (const auto &plugin : _pluginsInMem[PLUGIN_TYPE_ENGINE_DETECTION]) {
+		const MetaEngineDetection &metaEngine = plugin->get<MetaEngineDetection>();
+		Common::StringMap &games = _detectionIndex[metaEngine.getName()];
+
+		PlainGameList list = metaEngine.getSupportedGames();
+		for (const auto &game : list)
+			games[game.gameId] = game.description ? game.description : "";
+	}
+
+	Common::DumpFile out;
+	if (!out.open(path, true)) {
+		warning("Couldn't open detection index '%s' for writing", path.toString(Common::Path::kNativeSeparator).c_str());
+		return;
+	}
+
+	out.writeUint32BE(DETECTION_INDEX_TAG);
+	out.writeUint32BE(DETECTION_INDEX_VERSION);
+	writeIndexString(out, key);
+	out.writeUint32LE(_detectionIndex.size());
+	for (const auto &engine : _detectionIndex) {
+		writeIndexString(out, engine._key);
+		out.writeUint32LE(engine._value.size());
+		for (const auto &game : engine._value) {
+			writeIndexString(out, game._key);
+			writeIndexString(out, game._value);
+		}
+	}
+
+	if (!out.flush() || out.err())
+		warning("Failed to write detection index '%s'", path.toString(Common::Path::kNativeSeparator).c_str());
+}
 #endif
 
 void PluginManagerUncached::loadFirstPlugin() {
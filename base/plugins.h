@@ -24,6 +24,7 @@
 
 #include "common/array.h"
 #include "common/fs.h"
+#include "common/hash-str.h"
 #include "common/str.h"
 #include "backends/plugins/elf/version.h"
 
@@ -324,13 +325,26 @@ public:
 	virtual void loadDetectionPlugin() {}
 	virtual void unloadDetectionPlugin() {}
 
+	/**
+	 * Look up the description of a game in the index of the detection plugin,
+	 * which allows listing games without loading the detection plugin.
+	 *
+	 * @param engineId    The engine ID
+	 * @param gameId      The game ID
+	 * @param description Set to the game description, or empty if the engine
+	 *                    does not support the game
+	 *
+	 * @return false if there is no index, the detection plugin must then be queried.
+	 */
+	virtual bool findIndexedGame(const Common::String &engineId, const Common::String &gameId, Common::String &description) { return false; }
+
 	// Functions used only by the cached PluginManager
 	virtual void loadAllPlugins();
 	virtual void loadAllPluginsOfType(PluginType type);
 
 	void unloadPluginsExcept(PluginType type, const Plugin *plugin, bool deletePlugin = true);
 
-	const PluginList &getPlugins(PluginType t) { return _pluginsInMem[t]; }
+	virtual const PluginList &getPlugins(PluginType t) { return _pluginsInMem[t]; }
 };
 
 /**
@@ -346,7 +360,23 @@ protected:
 
 	bool _isDetectionLoaded;
 
+#ifndef DETECTION_STATIC
+	bool _isDetectionWanted;
+	bool _isDetectionIndexLoaded;
+	/** Descriptions of the games of each engine, by engine ID */
+	Common::HashMap<Common::String, Common::StringMap> _detectionIndex;
+
+	PluginManagerUncached() : _detectionPlugin(nullptr), _currentPlugin(nullptr), _isDetectionLoaded(false),
+		_isDetectionWanted(false), _isDetectionIndexLoaded(false) {}
+
+	void loadDetectionPluginNow();
+	Common::Path getDetectionIndexPath() const;
+	Common::String getDetectionIndexKey() const;
+	void loadDetectionIndex();
+	void saveDetectionIndex();
+#else
 	PluginManagerUncached() : _detectionPlugin(nullptr), _currentPlugin(nullptr), _isDetectionLoaded(false) {}
+#endif
 	bool loadPluginByFileName(const Common::Path &filename);
 
 public:
@@ -359,6 +389,8 @@ public:
 #ifndef DETECTION_STATIC
 	void loadDetectionPlugin() override;
 	void unloadDetectionPlugin() override;
+	bool findIndexedGame(const Common::String &engineId, const Common::String &gameId, Common::String &description) override;
+	const PluginList &getPlugins(PluginType t) override;
 #endif
 
 	void loadAllPlugins() override {} 	// we don't allow these
@@ -0,0 +1,450 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/compression/fastlz.h"
+#include "common/crc.h"
+#include "common/endian.h"
+#include "common/ptr.h"
+#include "common/stream.h"
+#include "common/util.h"
+
+namespace Common {
+
+namespace {
+
+enum {
+	kMinMatch = 4,
+	kMaxOffset = 65535,
+	kHashBits = 12,
+	kStoredFlag = 0x80000000
+};
+
+inline uint32 hashSequence(uint32 sequence) {
+	return (sequence * 2654435761U) >> (32 - kHashBits);
+}
+
+/**
+ * Write the extra bytes of a length which does not fit in its token nibble.
+ */
+inline byte *writeLength(byte *dst, uint32 length) {
+	for (length -= 15; length >= 255; length -= 255)
+		*dst++ = 255;
+	*dst++ = length;
+	return dst;
+}
+
+inline uint32 updateCRC(const CRC32 &crc, uint32 remainder, const byte *data, uint32 size) {
+	for (uint32 i = 0; i < size; i++)
+		remainder = crc.processByte(data[i], remainder);
+	return remainder;
+}
+
+inline bool readLength(const byte *&src, const byte *srcEnd, uint32 &length) {
+	byte b;
+	do {
+		if (src == srcEnd)
+			return false;
+		b = *src++;
+		length += b;
+	} while (b == 255);
+	return true;
+}
+
+} // End of anonymous namespace
+
+uint32 compressFastLZ(const byte *src, uint32 srcSize, byte *dst) {
+	assert(srcSize <= kFastLZBlockSize);
+
+	// Block offsets fit in 16 bits, which keeps the table small enough
+	// for the stack
+	uint16 table[1 << kHashBits];
+	memset(table, 0, sizeof(table));
+
+	const byte *ip = src;
+	const byte *anchor = src;
+	const byte *const end = src + srcSize;
+	byte *op = dst;
+
+	while (srcSize >= kMinMatch && ip <= end - kMinMatch) {
+		const uint32 sequence = READ_LE_UINT32(ip);
+		const uint32 hash = hashSequence(sequence);
+		const byte *ref = src + table[hash];
+		table[hash] = ip - src;
+
+		if (ref >= ip || ip - ref > kMaxOffset || READ_LE_UINT32(ref) != sequence) {
+			// Step faster through data which does not compress
+			ip += 1 + ((ip - anchor) >> 6);
+			continue;
+		}
+
+		const uint32 offset = ip - ref;
+		const byte *matchEnd = ip + kMinMatch;
+		ref += kMinMatch;
+		while (matchEnd < end && *matchEnd == *ref) {
+			matchEnd++;
+			ref++;
+		}
+
+		const uint32 literals = ip - anchor;
+		const uint32 matchLength = matchEnd - ip - kMinMatch;
+		if ((uint32)(op - dst) + 1 + literals + literals / 255 + 1 + 2 + matchLength / 255 + 1 >= srcSize)
+			return 0;
+
+		byte *token = op++;
+		*token = MIN<uint32>(literals, 15) << 4;
+		if (literals >= 15)
+			op = writeLength(op, literals);
+		memcpy(op, anchor, literals);
+		op += literals;
+
+		WRITE_LE_UINT16(op, offset);
+		op += 2;
+
+		*token |= MIN<uint32>(matchLength, 15);
+		if (matchLength >= 15)
+			op = writeLength(op, matchLength);
+
+		ip = anchor = matchEnd;
+	}
+
+	// The last sequence only has literals
+	const uint32 literals = end - anchor;
+	if ((uint32)(op - dst) + 1 + literals + literals / 255 + 1 >= srcSize)
+		return 0;
+
+	*op++ = MIN<uint32>(literals, 15) << 4;
+	if (literals >= 15)
+		op = writeLength(op, literals);
+	memcpy(op, anchor, literals);
+	op += literals;
+
+	return op - dst;
+}
+
+bool decompressFastLZ(const byte *src, uint32 srcSize, byte *dst, uint32 dstSize) {
+	const byte *ip = src;
+	const byte *const ipEnd = src + srcSize;
+	byte *op = dst;
+	byte *const opEnd = dst + dstSize;
+
+	while (ip < ipEnd) {
+		const byte token = *ip++;
+
+		uint32 length = token >> 4;
+		if (length == 15 && !readLength(ip, ipEnd, length))
+			return false;
+		if (length > (uint32)(ipEnd - ip) || length > (uint32)(opEnd - op))
+			return false;
+		memcpy(op, ip, length);
+		op += length;
+		ip += length;
+
+		if (ip == ipEnd)
+			break;
+
+		if (ipEnd - ip < 2)
+			return false;
+		const uint32 offset = READ_LE_UINT16(ip);
+		ip += 2;
+		if (offset == 0 || offset > (uint32)(op - dst))
+			return false;
+
+		length = token & 15;
+		if (length == 15 && !readLength(ip, ipEnd, length))
+			return false;
+		length += kMinMatch;
+		if (length > (uint32)(opEnd - op))
+			return false;
+
+		const byte *ref = op - offset;
+		if (offset >= length) {
+			memcpy(op, ref, length);
+			op += length;
+		} else {
+			// Overlapping match, repeating the last bytes
+			while (length--)
+				*op++ = *ref++;
+		}
+	}
+
+	return op == opEnd;
+}
+
+class FastLZReadStream : public SeekableReadStream {
+protected:
+	DisposablePtr<SeekableReadStream> _wrapped;
+	byte _block[kFastLZBlockSize];
+	byte _packed[kFastLZBlockSize];
+	uint32 _blockStart;
+	uint32 _blockSize;
+	uint32 _blockPos;
+	bool _blockDecoded;
+	bool _lastBlock;
+	uint32 _size;
+	uint32 _checksum;
+	CRC32 _crc;
+	uint32 _crcRemainder;
+	bool _crcComplete;
+	bool _eos;
+	bool _err;
+
+	void rewind() {
+		_wrapped->seek(4, SEEK_SET);
+		_blockStart = 0;
+		_blockSize = 0;
+		_blockPos = 0;
+		_blockDecoded = true;
+		_lastBlock = false;
+		_crcRemainder = _crc.getInitRemainder();
+		_crcComplete = true;
+	}
+
+	/**
+	 * Move to the next block. Its data is only decoded if the unpacked
+	 * position @p target lies in it, otherwise it is skipped.
+	 */
+	bool nextBlock(uint32 target) {
+		if (_lastBlock || _err)
+			return false;
+
+		_blockStart += _blockSize;
+		_blockSize = 0;
+		_blockPos = 0;
+
+		const uint32 unpackedSize = _wrapped->readUint32LE();
+		if (_wrapped->eos() || _wrapped->err()) {
+			_err = true;
+			return false;
+		}
+		if (unpackedSize == 0) {
+			// The checksum can only be verified if every block was decoded
+			_lastBlock = true;
+			if (_blockStart != _size || (_crcComplete && _crc.finalize(_crcRemainder) != _checksum))
+				_err = true;
+			return false;
+		}
+
+		uint32 packedSize = _wrapped->readUint32LE();
+		const bool stored = (packedSize & kStoredFlag) != 0;
+		packedSize &= ~kStoredFlag;
+		if (unpackedSize > kFastLZBlockSize || packedSize > unpackedSize || (stored && packedSize != unpackedSize)) {
+			_err = true;
+			return false;
+		}
+
+		_blockDecoded = target < _blockStart + unpackedSize;
+		if (!_blockDecoded) {
+			_wrapped->skip(packedSize);
+		} else if (stored) {
+			if (_wrapped->read(_block, unpackedSize) != unpackedSize)
+				_err = true;
+		} else {
+			if (_wrapped->read(_packed, packedSize) != packedSize ||
+				!decompressFastLZ(_packed, packedSize, _block, unpackedSize))
+				_err = true;
+		}
+		if (_err)
+			return false;
+
+		if (!_blockDecoded)
+			_crcComplete = false;
+		else if (_crcComplete)
+			_crcRemainder = updateCRC(_crc, _crcRemainder, _block, unpackedSize);
+
+		_blockSize = unpackedSize;
+		return true;
+	}
+
+public:
+	FastLZReadStream(SeekableReadStream *w, DisposeAfterUse::Flag disposeParent) : _wrapped(w, disposeParent), _eos(false), _err(false) {
+		// The checksum and unpacked size trail the stream, as in gzip
+		_wrapped->seek(-8, SEEK_END);
+		_checksum = _wrapped->readUint32LE();
+		_size = _wrapped->readUint32LE();
+		rewind();
+	}
+
+	bool err() const override { return _err || _wrapped->err(); }
+	void clearErr() override {
+		_eos = false;
+		_err = false;
+		_wrapped->clearErr();
+	}
+
+	uint32 read(void *dataPtr, uint32 dataSize) override {
+		byte *dst = (byte *)dataPtr;
+		uint32 total = 0;
+
+		while (total < dataSize) {
+			if (_blockPos == _blockSize) {
+				if (!nextBlock(_blockStart + _blockSize)) {
+					_eos = true;
+					break;
+				}
+				continue;
+			}
+
+			const uint32 count = MIN(dataSize - total, _blockSize - _blockPos);
+			memcpy(dst + total, _block + _blockPos, count);
+			_blockPos += count;
+			total += count;
+		}
+
+		return total;
+	}
+
+	bool eos() const override { return _eos; }
+	int64 pos() const override { return _blockStart + _blockPos; }
+	int64 size() const override { return _size; }
+
+	bool seek(int64 offset, int whence = SEEK_SET) override {
+		int64 target;
+		switch (whence) {
+		case SEEK_SET:
+			target = offset;
+			break;
+		case SEEK_CUR:
+			target = pos() + offset;
+			break;
+		case SEEK_END:
+			target = _size + offset;
+			break;
+		default:
+			return false;
+		}
+		if (target < 0 || target > _size)
+			return false;
+
+		if (target < _blockStart || (!_blockDecoded && target < _blockStart + _blockSize))
+			rewind();
+		while (target > _blockStart + _blockSize) {
+			if (!nextBlock(target))
+				return false;
+		}
+
+		_blockPos = target - _blockStart;
+		_eos = false;
+		return true;
+	}
+};
+
+class FastLZWriteStream : public WriteStream {
+protected:
+	ScopedPtr<WriteStream> _wrapped;
+	byte _block[kFastLZBlockSize];
+	byte _packed[kFastLZBlockSize];
+	uint32 _blockSize;
+	uint32 _pos;
+	CRC32 _crc;
+	uint32 _crcRemainder;
+	bool _finalized;
+
+	void flushBlock() {
+		if (!_blockSize)
+			return;
+
+		_crcRemainder = updateCRC(_crc, _crcRemainder, _block, _blockSize);
+
+		const uint32 packedSize = compressFastLZ(_block, _blockSize, _packed);
+		_wrapped->writeUint32LE(_blockSize);
+		if (packedSize) {
+			_wrapped->writeUint32LE(packedSize);
+			_wrapped->write(_packed, packedSize);
+		} else {
+			_wrapped->writeUint32LE(_blockSize | kStoredFlag);
+			_wrapped->write(_block, _blockSize);
+		}
+		_blockSize = 0;
+	}
+
+public:
+	FastLZWriteStream(WriteStream *w) : _wrapped(w), _blockSize(0), _pos(0), _finalized(false) {
+		_crcRemainder = _crc.getInitRemainder();
+		assert(w != nullptr);
+		_wrapped->writeUint32BE(MKTAG('S','V','L','Z'));
+	}
+
+	~FastLZWriteStream() {
+		finalize();
+	}
+
+	bool err() const override { return _wrapped->err(); }
+	void clearErr() override { _wrapped->clearErr(); }
+
+	void finalize() override {
+		if (_finalized)
+			return;
+		_finalized = true;
+
+		flushBlock();
+		_wrapped->writeUint32LE(0);
+		_wrapped->writeUint32LE(_crc.finalize(_crcRemainder));
+		_wrapped->writeUint32LE(_pos);
+		_wrapped->finalize();
+	}
+
+	uint32 write(const void *dataPtr, uint32 dataSize) override {
+		if (err() || _finalized)
+			return 0;
+
+		const byte *src = (const byte *)dataPtr;
+		uint32 remaining = dataSize;
+		while (remaining) {
+			const uint32 count = MIN<uint32>(remaining, kFastLZBlockSize - _blockSize);
+			memcpy(_block + _blockSize, src, count);
+			_blockSize += count;
+			src += count;
+			remaining -= count;
+			if (_blockSize == kFastLZBlockSize)
+				flushBlock();
+		}
+
+		_pos += dataSize;
+		return dataSize;
+	}
+
+	int64 pos() const override { return _pos; }
+};
+
+SeekableReadStream *wrapFastLZReadStream(SeekableReadStream *toBeWrapped, DisposeAfterUse::Flag disposeParent) {
+	if (!toBeWrapped)
+		return nullptr;
+
+	// Tag, terminating block, checksum and size at least
+	if (toBeWrapped->size() < 16)
+		return toBeWrapped;
+
+	const uint32 tag = toBeWrapped->readUint32BE();
+	toBeWrapped->seek(-4, SEEK_CUR);
+	if (tag != MKTAG('S','V','L','Z'))
+		return toBeWrapped;
+
+	return new FastLZReadStream(toBeWrapped, disposeParent);
+}
+
+WriteStream *wrapFastLZWriteStream(WriteStream *toBeWrapped) {
+	if (!toBeWrapped)
+		return nullptr;
+	return new FastLZWriteStream(toBeWrapped);
+}
+
+} // End of namespace Common
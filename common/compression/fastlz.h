@@ -0,0 +1,100 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef COMMON_FASTLZ_H
+#define COMMON_FASTLZ_H
+
+#include "common/scummsys.h"
+#include "common/types.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_fastlz Fast LZ compression
+ * @ingroup common
+ *
+ * @brief  Built-in LZ77 codec favoring speed over ratio.
+ *
+ * @details Byte-oriented LZ77 codec in the spirit of LZ4, used as a faster
+ *          alternative to deflate for save files. It does not depend on
+ *          any external library.
+ *
+ *          Streams start with the 'SVLZ' tag and are split in blocks of
+ *          at most 64 KB, each prefixed by its unpacked and packed sizes.
+ *          Blocks that do not shrink are stored as is. A terminating empty
+ *          block is followed by the CRC32 of the unpacked data and its
+ *          total size, like the gzip trailer. Reading a whole stream
+ *          reports an error if the checksum does not match.
+ * @{
+ */
+
+class SeekableReadStream;
+class WriteStream;
+
+enum {
+	kFastLZBlockSize = 65536
+};
+
+/**
+ * Compress a block of at most kFastLZBlockSize bytes. At most
+ * @p srcSize - 1 bytes are written to @p dst.
+ *
+ * @return The packed size, or 0 if the data could not be compressed in
+ *         less than @p srcSize bytes.
+ */
+uint32 compressFastLZ(const byte *src, uint32 srcSize, byte *dst);
+
+/**
+ * Decompress a block packed by compressFastLZ().
+ *
+ * @return Returns true if exactly @p dstSize bytes were decoded.
+ */
+bool decompressFastLZ(const byte *src, uint32 srcSize, byte *dst, uint32 dstSize);
+
+/**
+ * Take an arbitrary SeekableReadStream and wrap it in a custom stream which
+ * provides transparent on-the-fly decompression, if its data starts with the
+ * fast LZ tag. Otherwise the stream is returned unmodified.
+ * The created stream also becomes responsible for freeing the passed stream,
+ * if @p disposeParent is set.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned).
+ */
+SeekableReadStream *wrapFastLZReadStream(SeekableReadStream *toBeWrapped,
+		DisposeAfterUse::Flag disposeParent = DisposeAfterUse::YES);
+
+/**
+ * Take an arbitrary WriteStream and wrap it in a custom stream which provides
+ * transparent on-the-fly compression in the fast LZ format.
+ * The created stream also becomes responsible for freeing the passed stream.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned).
+ */
+WriteStream *wrapFastLZWriteStream(WriteStream *toBeWrapped);
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
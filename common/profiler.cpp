@@ -0,0 +1,153 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/profiler.h"
+
+#ifdef ENABLE_PROFILER
+
+#include "common/system.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(Profiler);
+
+Profiler::Profiler() : _capturing(false), _maxEvents(0), _droppedEvents(0), _captureStart(0), _lastFrameStart(0), _frameCount(0) {
+	memset(_frameTimes, 0, sizeof(_frameTimes));
+}
+
+void Profiler::addZone(const char *name, uint64 start, uint64 end, ProfilerThread thread) {
+	const uint64 duration = end - start;
+	StackLock lock(_mutex);
+
+	uint i = 0;
+	while (i < _currentZones.size() && _currentZones[i].name != name)
+		i++;
+	if (i == _currentZones.size()) {
+		ZoneStats stats = { name, 0, 0 };
+		_currentZones.push_back(stats);
+	}
+	_currentZones[i].calls++;
+	_currentZones[i].micros += duration;
+
+	if (!_capturing)
+		return;
+
+	if (_events.size() >= _maxEvents) {
+		_droppedEvents++;
+		return;
+	}
+	Event event = { name, start, (uint32)MIN<uint64>(duration, 0xFFFFFFFF), thread };
+	_events.push_back(event);
+}
+
+void Profiler::markFrame() {
+	const uint64 now = g_system->getMicros();
+	StackLock lock(_mutex);
+
+	if (_lastFrameStart != 0) {
+		_frameTimes[_frameCount % kFrameHistory] = (now - _lastFrameStart) / 1000.0f;
+		_frameCount++;
+	}
+	_lastFrameStart = now;
+
+	_lastZones = _currentZones;
+	_currentZones.clear();
+
+	if (_capturing)
+		_frameStarts.push_back(now);
+}
+
+void Profiler::startCapture(uint maxEvents) {
+	StackLock lock(_mutex);
+	_events.clear();
+	_frameStarts.clear();
+	_events.reserve(MIN<uint>(maxEvents, 64 * 1024));
+	_maxEvents = maxEvents;
+	_droppedEvents = 0;
+	_captureStart = g_system->getMicros();
+	_capturing = true;
+}
+
+void Profiler::stopCapture() {
+	StackLock lock(_mutex);
+	_capturing = false;
+	if (_droppedEvents)
+		warning("Profiler: %u zones were dropped, the capture was full", _droppedEvents);
+}
+
+static String escapeJSON(const char *str) {
+	String result;
+	for (; *str; str++) {
+		if (*str == '"' || *str == '\\')
+			result += '\\';
+		result += *str;
+	}
+	return result;
+}
+
+bool Profiler::exportChromeTrace(WriteStream &stream) {
+	StackLock lock(_mutex);
+
+	stream.writeString("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	stream.writeString("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"main\"}},\n");
+	stream.writeString("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"audio\"}}");
+
+	for (uint i = 0; i < _frameStarts.size(); i++) {
+		const uint64 ts = _frameStarts[i] - MIN(_frameStarts[i], _captureStart);
+		stream.writeString(String::format(",\n{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":%llu}",
+		                                  (unsigned long long)ts));
+	}
+
+	for (uint i = 0; i < _events.size(); i++) {
+		const Event &event = _events[i];
+		// zones that started before the capture are clamped to its start
+		const uint64 ts = event.start - MIN(event.start, _captureStart);
+		stream.writeString(String::format(",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%llu,\"dur\":%u}",
+		                                  escapeJSON(event.name).c_str(), (int)event.thread, (unsigned long long)ts, event.duration));
+	}
+
+	stream.writeString("\n]}\n");
+	return !stream.err();
+}
+
+void Profiler::getFrameTimes(Array<float> &times) {
+	StackLock lock(_mutex);
+	const uint count = MIN<uint>(_frameCount, kFrameHistory);
+	times.resize(count);
+	for (uint i = 0; i < count; i++)
+		times[i] = _frameTimes[(_frameCount - count + i) % kFrameHistory];
+}
+
+void Profiler::getLastFrameZones(Array<ZoneStats> &zones) {
+	StackLock lock(_mutex);
+	zones = _lastZones;
+}
+
+ProfilerZone::ProfilerZone(const char *name, ProfilerThread thread) : _name(name), _thread(thread), _start(g_system->getMicros()) {
+}
+
+ProfilerZone::~ProfilerZone() {
+	Profiler::instance().addZone(_name, _start, g_system->getMicros(), _thread);
+}
+
+} // End of namespace Common
+
+#endif // ENABLE_PROFILER
@@ -0,0 +1,160 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/scummsys.h"
+
+#ifdef ENABLE_PROFILER
+
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
+#include "common/stream.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_profiler Profiler
+ * @ingroup common
+ *
+ * @brief API for timing the work done in each frame.
+ *
+ * Code is instrumented with PROFILE_ZONE(), which times the enclosing
+ * scope. When ScummVM is configured without --enable-profiler, the
+ * macros expand to nothing.
+ * @{
+ */
+
+/** Timeline a zone is shown on in the exported traces. */
+enum ProfilerThread {
+	kProfilerThreadMain = 0,
+	kProfilerThreadAudio = 1
+};
+
+/**
+ * Collects the time spent in named zones.
+ *
+ * The totals of the zones of the last frame and the recent frame times are
+ * always kept, for overlays. While a capture runs, each zone is stored as
+ * well so the capture can be exported as Chrome trace events, which can be
+ * opened in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Zones may end on any thread: the mixer callback runs on the audio thread.
+ */
+class Profiler : public Singleton<Profiler> {
+public:
+	struct ZoneStats {
+		const char *name;
+		uint32 calls;
+		uint64 micros; /**< Time spent in the zone, including its nested zones */
+	};
+
+	enum {
+		kFrameHistory = 240,
+		kDefaultMaxEvents = 1024 * 1024
+	};
+
+	Profiler();
+
+	/** Record a zone. The name must be a string literal. */
+	void addZone(const char *name, uint64 start, uint64 end, ProfilerThread thread);
+
+	/** Mark the start of a new frame. */
+	void markFrame();
+
+	/**
+	 * Start storing every zone, until stopCapture() is called or
+	 * maxEvents zones have been stored.
+	 */
+	void startCapture(uint maxEvents = kDefaultMaxEvents);
+	void stopCapture();
+	bool isCapturing() const { return _capturing; }
+	uint getCapturedCount() const { return _events.size(); }
+
+	/** Write the last capture as Chrome trace event JSON. */
+	bool exportChromeTrace(WriteStream &stream);
+
+	/** Get the durations in milliseconds of the last frames, oldest first. */
+	void getFrameTimes(Array<float> &times);
+	/** Get the zones of the last complete frame. */
+	void getLastFrameZones(Array<ZoneStats> &zones);
+
+private:
+	struct Event {
+		const char *name;
+		uint64 start;
+		uint32 duration;
+		ProfilerThread thread;
+	};
+
+	Mutex _mutex;
+
+	bool _capturing;
+	uint _maxEvents;
+	uint _droppedEvents;
+	uint64 _captureStart;
+	Array<Event> _events;
+	Array<uint64> _frameStarts;
+
+	uint64 _lastFrameStart;
+	float _frameTimes[kFrameHistory];
+	uint _frameCount;
+	Array<ZoneStats> _currentZones;
+	Array<ZoneStats> _lastZones;
+};
+
+/** Time the enclosing scope, see PROFILE_ZONE(). */
+class ProfilerZone {
+public:
+	ProfilerZone(const char *name, ProfilerThread thread = kProfilerThreadMain);
+	~ProfilerZone();
+
+private:
+	const char *_name;
+	ProfilerThread _thread;
+	uint64 _start;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+
+/** Time the enclosing scope as a zone called name. */
+#define PROFILE_ZONE(name) Common::ProfilerZone PROFILER_CONCAT(profilerZone, __LINE__)(name)
+/** Time the enclosing scope, which runs on another thread than the main one. */
+#define PROFILE_ZONE_THREAD(name, thread) Common::ProfilerZone PROFILER_CONCAT(profilerZone, __LINE__)(name, thread)
+/** Mark the start of a frame. */
+#define PROFILE_FRAME() Common::Profiler::instance().markFrame()
+
+#else
+
+#define PROFILE_ZONE(name) do {} while (0)
+#define PROFILE_ZONE_THREAD(name, thread) do {} while (0)
+#define PROFILE_FRAME() do {} while (0)
+
+#endif // ENABLE_PROFILER
+
+#endif
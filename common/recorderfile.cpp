@@ -334,6 +334,7 @@ bool PlaybackFile::hasNextEvent() const {
 RecorderEvent PlaybackFile::getNextEvent() {
 	if (!hasNextEvent()) {
 		debug(3, "end of recorder file reached.");
+		g_eventRec.reportBenchmark();
 		g_system->quit();
 	}
 
@@ -798,8 +799,10 @@ void PlaybackFile::checkRecordedMD5() {
 	if (memcmp(savedMD5, currentMD5, 16) != 0) {
 		debugC(1, kDebugLevelEventRec, "playback:action=\"Check screenshot\" time=%s result = fail", screenTime.c_str());
 		warning("Recorded and current screenshots are different");
+		g_eventRec.processScreenCheck(false);
 	} else {
 		debugC(1, kDebugLevelEventRec, "playback:action=\"Check screenshot\" time=%s result = success", screenTime.c_str());
+		g_eventRec.processScreenCheck(true);
 	}
 	Graphics::saveThumbnail(*_screenshotsFile, screen);
 	screen.free();
@@ -30,6 +30,8 @@
 
 namespace Common {
 
+class MemoryWriteStreamDynamic;
+
 /**
  * @defgroup common_savefile Save files
  * @ingroup common
@@ -276,6 +278,71 @@ public:
 	 * @return true if the file exists. false otherwise.
 	 */
 	virtual bool exists(const String &name) = 0;
+
+	/**
+	 * Get the metadata stored by setCachedMetaInfo() for a save file.
+	 *
+	 * Nothing is returned when the save file changed since the metadata was
+	 * stored. This allows listing saves without opening and decompressing
+	 * each of them.
+	 *
+	 * @param index  Name of the index the metadata is kept in, usually the target.
+	 * @param name   Name of the save file.
+	 * @param data   Receives the metadata.
+	 *
+	 * @return true if up-to-date metadata was found. false otherwise.
+	 */
+	virtual bool getCachedMetaInfo(const String &index, const String &name, Array<byte> &data) { return false; }
+
+	/**
+	 * Store the metadata of a save file, see getCachedMetaInfo().
+	 *
+	 * @param index  Name of the index the metadata is kept in, usually the target.
+	 * @param name   Name of the save file.
+	 * @param data   Metadata, in a format chosen by the caller.
+	 */
+	virtual void setCachedMetaInfo(const String &index, const String &name, const Array<byte> &data) {}
+
+	/**
+	 * Write the metadata indexes modified since the last call to storage.
+	 */
+	virtual void flushCachedMetaInfo() {}
+
+	/**
+	 * Write a save file from a buffer in the background, so that compressing
+	 * and writing it does not hold up the game.
+	 *
+	 * An existing file is only replaced once the new one has been completely
+	 * written. Listing, loading, overwriting or removing the file waits until
+	 * then. The default implementation writes it immediately.
+	 *
+	 * @param name      Name of the save file.
+	 * @param data      Uncompressed save data. The save file manager takes ownership of it.
+	 * @param compress  Whether to compress the resulting save file (default) or not.
+	 *
+	 * @return true if the save file could be created. false otherwise.
+	 */
+	virtual bool saveInBackground(const String &name, MemoryWriteStreamDynamic *data, bool compress = true);
+
+	/**
+	 * Check whether a save file passed to saveInBackground() is still being written.
+	 *
+	 * @param name Name of the save file.
+	 */
+	virtual bool isSavingInBackground(const String &name) { return false; }
+
+	/**
+	 * Wait until all the save files passed to saveInBackground() are written.
+	 */
+	virtual void finishBackgroundSaves() {}
+
+	/**
+	 * Make progress on the save files passed to saveInBackground(), and
+	 * write those which are complete. Called regularly from the main
+	 * thread while an engine runs, so this must only do a small amount of
+	 * work each time.
+	 */
+	virtual void pollBackgroundSaves() {}
 };
 
 /** @} */
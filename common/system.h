@@ -1549,6 +1549,15 @@ public:
 	 */
 	virtual uint32 getMillis(bool skipRecord = false) = 0;
 
+	/**
+	 * Get the number of microseconds since an arbitrary point in time, with
+	 * the best resolution the system offers.
+	 *
+	 * This is meant for measuring durations when profiling, the value is
+	 * never recorded by the event recorder.
+	 */
+	virtual uint64 getMicros() { return (uint64)getMillis(true) * 1000; }
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
@@ -29,6 +29,7 @@
 
 #include "common/memstream.h"
 #include "common/rect.h"
+#include "common/system.h"
 #include "common/util.h"
 
 namespace BladeRunner {
@@ -77,6 +78,19 @@ SliceRenderer::SliceRenderer(BladeRunnerEngine *vm) {
 	for (int i = 0; i < 12; ++i) {
 		_shadowPolygonCurrent[i] = Vector3(0.0f, 0.0f, 0.0f);
 	}
+
+	for (int i = 0; i < ARRAYSIZE(_litColors); ++i) {
+		_litColors[i].stamp = 0;
+	}
+	_litColorsStamp        = 0;
+	_litColorsPaletteIndex = 0;
+
+	_drawSliceSpan = drawSliceSpanGeneric;
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+		_drawSliceSpan = drawSliceSpanSSE2;
+	}
+#endif
 }
 
 SliceRenderer::~SliceRenderer() {
@@ -537,6 +551,62 @@ void SliceRenderer::drawOnScreen(int animationId, int animationFrame, int screen
 	}
 }
 
+void drawSliceSpanGeneric(uint16 *zbufferLine, byte *dst, uint bytesPerPixel, int count, uint16 z, uint32 color) {
+	switch (bytesPerPixel) {
+	case 1:
+		for (int x = 0; x < count; ++x) {
+			if (z < zbufferLine[x]) {
+				zbufferLine[x] = z;
+				dst[x] = (uint8)color;
+			}
+		}
+		break;
+	case 2:
+		for (int x = 0; x < count; ++x) {
+			if (z < zbufferLine[x]) {
+				zbufferLine[x] = z;
+				((uint16 *)dst)[x] = (uint16)color;
+			}
+		}
+		break;
+	case 4:
+		for (int x = 0; x < count; ++x) {
+			if (z < zbufferLine[x]) {
+				zbufferLine[x] = z;
+				((uint32 *)dst)[x] = color;
+			}
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void SliceRenderer::updateLitColorsStamp() {
+	if (_litColorsStamp != 0
+	 && _litColorsPaletteIndex == _framePaletteIndex
+	 && _litColorsLightsColor.r == _lightsColor.r
+	 && _litColorsLightsColor.g == _lightsColor.g
+	 && _litColorsLightsColor.b == _lightsColor.b
+	 && _litColorsSetEffectColor.r == _setEffectColor.r
+	 && _litColorsSetEffectColor.g == _setEffectColor.g
+	 && _litColorsSetEffectColor.b == _setEffectColor.b) {
+		return;
+	}
+
+	++_litColorsStamp;
+	if (_litColorsStamp == 0) {
+		// Wrapped around, make sure no entry looks valid
+		for (int i = 0; i < ARRAYSIZE(_litColors); ++i) {
+			_litColors[i].stamp = 0;
+		}
+		_litColorsStamp = 1;
+	}
+	_litColorsPaletteIndex   = _framePaletteIndex;
+	_litColorsLightsColor    = _lightsColor;
+	_litColorsSetEffectColor = _setEffectColor;
+}
+
 void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine) {
 	if (slice < 0 || (uint32)slice >= _frameSliceCount) {
 		return;
@@ -544,6 +614,13 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 
 	SliceAnimations::Palette &palette = _vm->_sliceAnimations->getPalette(_framePaletteIndex);
 
+	if (advanced) {
+		updateLitColorsStamp();
+	}
+
+	const uint bytesPerPixel = surface.format.bytesPerPixel;
+	byte *dstLine = (byte *)surface.getBasePtr(0, CLIP(y, 0, surface.h - 1));
+
 	byte *p = (byte *)_sliceFramePtr + 0x20 + 4 * slice;
 
 	uint32 polyOffset = READ_LE_UINT32(p);
@@ -577,19 +654,38 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 						Color256 aescColor = { 0, 0, 0 };
 						_screenEffects->getColor(&aescColor, vertexX, y, vertexZ);
 
-						Color256 color = palette.color[p[2]];
-						color.r = ((int)(_setEffectColor.r + _lightsColor.r * color.r) / 65536) + aescColor.r;
-						color.g = ((int)(_setEffectColor.g + _lightsColor.g * color.g) / 65536) + aescColor.g;
-						color.b = ((int)(_setEffectColor.b + _lightsColor.b * color.b) / 65536) + aescColor.b;
-						// We need to convert from 5 bits per channel (r,g,b) to 8 bits
-						outColor = _pixelFormat.RGBToColor(Color::get8BitColorFrom5Bit(color.r), Color::get8BitColorFrom5Bit(color.g), Color::get8BitColorFrom5Bit(color.b));
+						LitColor &litColor = _litColors[p[2]];
+						if (litColor.stamp != _litColorsStamp) {
+							Color256 color = palette.color[p[2]];
+							litColor.color.r = (int)(_setEffectColor.r + _lightsColor.r * color.r) / 65536;
+							litColor.color.g = (int)(_setEffectColor.g + _lightsColor.g * color.g) / 65536;
+							litColor.color.b = (int)(_setEffectColor.b + _lightsColor.b * color.b) / 65536;
+							litColor.value = _pixelFormat.RGBToColor(Color::get8BitColorFrom5Bit(litColor.color.r), Color::get8BitColorFrom5Bit(litColor.color.g), Color::get8BitColorFrom5Bit(litColor.color.b));
+							litColor.stamp = _litColorsStamp;
+						}
+
+						if (aescColor.r == 0 && aescColor.g == 0 && aescColor.b == 0) {
+							outColor = litColor.value;
+						} else {
+							Color256 color;
+							color.r = litColor.color.r + aescColor.r;
+							color.g = litColor.color.g + aescColor.g;
+							color.b = litColor.color.b + aescColor.b;
+							// We need to convert from 5 bits per channel (r,g,b) to 8 bits
+							outColor = _pixelFormat.RGBToColor(Color::get8BitColorFrom5Bit(color.r), Color::get8BitColorFrom5Bit(color.g), Color::get8BitColorFrom5Bit(color.b));
+						}
 					}
 
-					for (int x = previousVertexX; x != vertexX; ++x) {
+					// Pixels past the right edge of a narrower surface are clamped to its last column
+					int spanEnd = MIN<int>(vertexX, surface.w);
+					if (previousVertexX < spanEnd) {
+						_drawSliceSpan(zbufferLine + previousVertexX, dstLine + previousVertexX * bytesPerPixel, bytesPerPixel, spanEnd - previousVertexX, (uint16)vertexZ, outColor);
+					}
+					for (int x = MAX(previousVertexX, spanEnd); x < vertexX; ++x) {
 						if (vertexZ < zbufferLine[x]) {
 							zbufferLine[x] = (uint16)vertexZ;
 
-							void *dstPtr = surface.getBasePtr(CLIP(x, 0, surface.w - 1), CLIP(y, 0, surface.h - 1));
+							void *dstPtr = surface.getBasePtr(surface.w - 1, CLIP(y, 0, surface.h - 1));
 							drawPixel(surface, dstPtr, outColor);
 						}
 					}
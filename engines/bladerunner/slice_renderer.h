@@ -42,7 +42,25 @@ class BladeRunnerEngine;
 class Lights;
 class SetEffects;
 
+/**
+ * Z-tests a horizontal span of one slice polygon against a z-buffer line and
+ * writes color to every pixel that passes. dst points to the first pixel of
+ * the span, which has bytesPerPixel bytes per pixel.
+ */
+typedef void (*SliceSpanDrawer)(uint16 *zbufferLine, byte *dst, uint bytesPerPixel, int count, uint16 z, uint32 color);
+
+void drawSliceSpanGeneric(uint16 *zbufferLine, byte *dst, uint bytesPerPixel, int count, uint16 z, uint32 color);
+#ifdef SCUMMVM_SSE2
+void drawSliceSpanSSE2(uint16 *zbufferLine, byte *dst, uint bytesPerPixel, int count, uint16 z, uint32 color);
+#endif
+
 class SliceRenderer {
+	struct LitColor {
+		uint32   stamp;
+		Color256 color;
+		uint32   value;
+	};
+
 	BladeRunnerEngine *_vm;
 
 	int       _animation;
@@ -88,7 +106,16 @@ class SliceRenderer {
 	Color _setEffectColor;
 	Color _lightsColor;
 
+	// Lit palette colors, valid while the lighting and the palette are the
+	// same as when _litColorsStamp was last increased
+	LitColor _litColors[256];
+	uint32   _litColorsStamp;
+	Color    _litColorsSetEffectColor;
+	Color    _litColorsLightsColor;
+	uint32   _litColorsPaletteIndex;
+
 	Graphics::PixelFormat _pixelFormat;
+	SliceSpanDrawer       _drawSliceSpan;
 
 public:
 	SliceRenderer(BladeRunnerEngine *vm);
@@ -114,6 +141,7 @@ private:
 	void loadFrame(int animation, int frame);
 
 	void drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine);
+	void updateLitColorsStamp();
 	void drawShadowInWorld(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 	void drawShadowPolygon(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 };
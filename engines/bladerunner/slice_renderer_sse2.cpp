@@ -0,0 +1,104 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "bladerunner/slice_renderer.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace BladeRunner {
+
+void drawSliceSpanSSE2(uint16 *zbufferLine, byte *dst, uint bytesPerPixel, int count, uint16 z, uint32 color) {
+	if (bytesPerPixel != 2 && bytesPerPixel != 4) {
+		drawSliceSpanGeneric(zbufferLine, dst, bytesPerPixel, count, z, color);
+		return;
+	}
+
+	// SSE2 only has signed 16-bit compares, so flip the sign bit of both
+	// sides to compare the z values as unsigned
+	const __m128i signBit = _mm_set1_epi16((short)0x8000);
+	const __m128i zRaw    = _mm_set1_epi16((short)z);
+	const __m128i zSigned = _mm_xor_si128(zRaw, signBit);
+	const __m128i color16 = _mm_set1_epi16((short)color);
+	const __m128i color32 = _mm_set1_epi32((int)color);
+
+	for (; count >= 8; count -= 8, zbufferLine += 8, dst += 8 * bytesPerPixel) {
+		const __m128i zbuffer = _mm_loadu_si128((const __m128i *)zbufferLine);
+		// mask is set where z < zbuffer
+		const __m128i mask = _mm_cmpgt_epi16(_mm_xor_si128(zbuffer, signBit), zSigned);
+		const int maskBits = _mm_movemask_epi8(mask);
+
+		if (maskBits == 0) {
+			continue;
+		}
+
+		if (maskBits == 0xFFFF) {
+			_mm_storeu_si128((__m128i *)zbufferLine, zRaw);
+			if (bytesPerPixel == 2) {
+				_mm_storeu_si128((__m128i *)dst, color16);
+			} else {
+				_mm_storeu_si128((__m128i *)dst, color32);
+				_mm_storeu_si128((__m128i *)(dst + 16), color32);
+			}
+			continue;
+		}
+
+		_mm_storeu_si128((__m128i *)zbufferLine, _mm_or_si128(_mm_and_si128(mask, zRaw), _mm_andnot_si128(mask, zbuffer)));
+
+		if (bytesPerPixel == 2) {
+			const __m128i pixels = _mm_loadu_si128((const __m128i *)dst);
+			_mm_storeu_si128((__m128i *)dst, _mm_or_si128(_mm_and_si128(mask, color16), _mm_andnot_si128(mask, pixels)));
+		} else {
+			const __m128i maskLo = _mm_unpacklo_epi16(mask, mask);
+			const __m128i maskHi = _mm_unpackhi_epi16(mask, mask);
+			const __m128i pixelsLo = _mm_loadu_si128((const __m128i *)dst);
+			const __m128i pixelsHi = _mm_loadu_si128((const __m128i *)(dst + 16));
+			_mm_storeu_si128((__m128i *)dst,        _mm_or_si128(_mm_and_si128(maskLo, color32), _mm_andnot_si128(maskLo, pixelsLo)));
+			_mm_storeu_si128((__m128i *)(dst + 16), _mm_or_si128(_mm_and_si128(maskHi, color32), _mm_andnot_si128(maskHi, pixelsHi)));
+		}
+	}
+
+	drawSliceSpanGeneric(zbufferLine, dst, bytesPerPixel, count, z, color);
+}
+
+} // End of namespace BladeRunner
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
@@ -395,6 +395,7 @@ bool VQADecoder::VQAVideoTrack::readVQFR(Common::SeekableReadStream *s, uint32 s
 			codebookInfo.data = _codebookInfoNext->data;
 			codebookInfo.size = bytesDecomprsd;
 			_codebookInfoNext->data = intermediateSwapPtr;
+			++_codebookVersion;
 
 			_countOfCBPsToCBF = 0;
 			_accumulatedCBPZsizeToCBF = 0;
@@ -743,6 +744,14 @@ VQADecoder::VQAVideoTrack::VQAVideoTrack(VQADecoder *vqaDecoder) {
 	_codebookInfoNext         = nullptr; // stores the decompressed codebook parts and it's swapped with the active codebook
 	_countOfCBPsToCBF         = 0;
 	_accumulatedCBPZsizeToCBF = 0;
+	_codebookVersion          = 0;
+
+	_convertedCodebook         = nullptr;
+	_convertedCodebookAlpha    = nullptr;
+	_convertedCodebookPixels   = 0;
+	_convertedCodebookCapacity = 0;
+	_convertedCodebookSource   = nullptr;
+	_convertedCodebookVersion  = 0;
 }
 
 VQADecoder::VQAVideoTrack::~VQAVideoTrack() {
@@ -763,6 +772,9 @@ VQADecoder::VQAVideoTrack::~VQAVideoTrack() {
 		delete[] _codebookInfoNext->data;
 	}
 	delete _codebookInfoNext;
+
+	delete[] _convertedCodebook;
+	delete[] _convertedCodebookAlpha;
 }
 
 uint16 VQADecoder::VQAVideoTrack::getWidth() const {
@@ -849,6 +861,7 @@ bool VQADecoder::VQAVideoTrack::readCBFZ(Common::SeekableReadStream *s, uint32 s
 
 	uint32 bytesDecomprsd = decompress_lcw(_cbfz, size, codebookInfo.data, codebookSize);
 	codebookInfo.size = bytesDecomprsd;
+	++_codebookVersion;
 	return true;
 }
 
@@ -1093,40 +1106,96 @@ bool VQADecoder::VQAVideoTrack::readVPTR(Common::SeekableReadStream *s, uint32 s
 	return true;
 }
 
-void VQADecoder::VQAVideoTrack::VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha) {
-	const uint8 *const block_src = &_codebook[2 * srcBlock * _blockW * _blockH];
+void VQADecoder::VQAVideoTrack::updateConvertedCodebook(const CodebookInfo &codebookInfo, const Graphics::PixelFormat &format) {
+	if (_convertedCodebookSource == codebookInfo.data
+	 && _convertedCodebookVersion == _codebookVersion
+	 && _convertedCodebookFormat == format) {
+		return;
+	}
 
-	uint16 blocks_per_line = _width / _blockW;
+	uint32 pixels = codebookInfo.size / 2;
+	if (pixels > _convertedCodebookCapacity) {
+		delete[] _convertedCodebook;
+		delete[] _convertedCodebookAlpha;
+		_convertedCodebook         = new uint32[pixels];
+		_convertedCodebookAlpha    = new uint8[pixels];
+		_convertedCodebookCapacity = pixels;
+	}
 
-	uint32 intermDiv = 0;
-	uint32 dst_x = 0;
-	uint32 dst_y = 0;
-	uint16 vqaColor = 0;
+	// Converting each codebook entry once is much cheaper than converting
+	// every pixel of every frame, as codebooks change rarely.
+	const uint8 *src = codebookInfo.data;
 	uint8 a, r, g, b;
+	for (uint32 i = 0; i < pixels; ++i) {
+		getGameDataColor(READ_LE_UINT16(src), a, r, g, b);
+		src += 2;
+		// Ignore the alpha in the output as it is inversed in the input
+		_convertedCodebook[i]      = format.RGBToColor(r, g, b);
+		_convertedCodebookAlpha[i] = a;
+	}
 
-	for (uint i = count; i != 0; --i) {
-		// aux variable to avoid duplicate division and a modulo operation
-		intermDiv = (dstBlock + count - i) / blocks_per_line; // start of current blocks line
-		dst_x = ((dstBlock + count - i) - intermDiv * blocks_per_line) * _blockW + _offsetX;
-		dst_y = intermDiv * _blockH + _offsetY;
-
-		const uint8 *src_p = block_src;
-
-		for (uint y = _blockH; y != 0; --y) {
-			for (uint x = _blockW; x != 0; --x) {
-				vqaColor = READ_LE_UINT16(src_p);
-				src_p += 2;
-
-				getGameDataColor(vqaColor, a, r, g, b);
-
-				if (!(alpha && a)) {
-					// CLIP() is too slow and it is not needed.
-					// void* dstPtr = surface->getBasePtr(CLIP(dst_x + x, (uint32)0, (uint32)(surface->w - 1)), CLIP(dst_y + y, (uint32)0, (uint32)(surface->h - 1)));
-					void* dstPtr = surface->getBasePtr(dst_x + _blockW - x, dst_y + _blockH - y);
-					// Ignore the alpha in the output as it is inversed in the input
-					drawPixel(*surface, dstPtr, surface->format.RGBToColor(r, g, b));
+	_convertedCodebookPixels  = pixels;
+	_convertedCodebookSource  = codebookInfo.data;
+	_convertedCodebookVersion = _codebookVersion;
+	_convertedCodebookFormat  = format;
+}
+
+template<typename PixelType>
+static inline void writeConvertedBlock(PixelType *dst, uint pitch, const uint32 *colors, const uint8 *alphas, uint blockW, uint blockH, bool alpha) {
+	for (uint y = blockH; y != 0; --y) {
+		if (alpha) {
+			for (uint x = 0; x < blockW; ++x) {
+				if (!alphas[x]) {
+					dst[x] = (PixelType)colors[x];
 				}
 			}
+		} else {
+			for (uint x = 0; x < blockW; ++x) {
+				dst[x] = (PixelType)colors[x];
+			}
+		}
+		colors += blockW;
+		alphas += blockW;
+		dst = (PixelType *)((byte *)dst + pitch);
+	}
+}
+
+void VQADecoder::VQAVideoTrack::VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha) {
+	const uint32 blockSize = _blockW * _blockH;
+	if ((srcBlock + 1) * blockSize > _convertedCodebookPixels) {
+		return;
+	}
+
+	const uint32 *colors = &_convertedCodebook[srcBlock * blockSize];
+	const uint8  *alphas = &_convertedCodebookAlpha[srcBlock * blockSize];
+
+	uint16 blocks_per_line = _width / _blockW;
+
+	uint32 dst_x = (dstBlock % blocks_per_line) * _blockW + _offsetX;
+	uint32 dst_y = (dstBlock / blocks_per_line) * _blockH + _offsetY;
+	const uint32 end_x = blocks_per_line * _blockW + _offsetX;
+
+	for (uint i = count; i != 0; --i) {
+		void *dstPtr = surface->getBasePtr(dst_x, dst_y);
+
+		switch (surface->format.bytesPerPixel) {
+		case 1:
+			writeConvertedBlock((uint8 *)dstPtr, surface->pitch, colors, alphas, _blockW, _blockH, alpha);
+			break;
+		case 2:
+			writeConvertedBlock((uint16 *)dstPtr, surface->pitch, colors, alphas, _blockW, _blockH, alpha);
+			break;
+		case 4:
+			writeConvertedBlock((uint32 *)dstPtr, surface->pitch, colors, alphas, _blockW, _blockH, alpha);
+			break;
+		default:
+			break;
+		}
+
+		dst_x += _blockW;
+		if (dst_x >= end_x) {
+			dst_x = _offsetX;
+			dst_y += _blockH;
 		}
 	}
 }
@@ -1142,6 +1211,10 @@ bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
 	if (!_codebook || !_vpointer)
 		return false;
 
+	if (!_vqaDecoder->_oldV2VQA) {
+		updateConvertedCodebook(codebookInfo, surface->format);
+	}
+
 	uint8 *src = _vpointer;
 	uint8 *end = _vpointer + _vpointerSize;
 
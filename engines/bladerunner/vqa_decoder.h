@@ -278,7 +278,19 @@ public:
 		uint32         _accumulatedCBPZsizeToCBF;
 
 		CodebookInfo  *_codebookInfoNext; // Used to store the decompressed codebook data and swap with the active codebook
-
+		uint32         _codebookVersion;  // Increased every time codebook data is (re)written
+
+		// The active codebook, converted to the output surface format,
+		// so that block expansion is a plain copy of surface pixels.
+		uint32                *_convertedCodebook;
+		uint8                 *_convertedCodebookAlpha;
+		uint32                 _convertedCodebookPixels;
+		uint32                 _convertedCodebookCapacity;
+		const uint8           *_convertedCodebookSource;
+		uint32                 _convertedCodebookVersion;
+		Graphics::PixelFormat  _convertedCodebookFormat;
+
+		void updateConvertedCodebook(const CodebookInfo &codebookInfo, const Graphics::PixelFormat &format);
 		void VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha = false);
 		bool decodeFrame(Graphics::Surface *surface);
 	};
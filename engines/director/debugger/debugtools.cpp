@@ -361,6 +361,7 @@ void onImGuiRender() {
 			ImGui::MenuItem("Watched Vars", NULL, &_state->_w.watchedVars);
 			ImGui::MenuItem("Logger", NULL, &_state->_w.logger);
 			ImGui::MenuItem("Archive", NULL, &_state->_w.archive);
+			ImGui::MenuItem("Profiler", NULL, &_state->_w.profiler);
 
 			ImGui::SeparatorText("Misc");
 			if (ImGui::MenuItem("Save state")) {
@@ -390,6 +391,7 @@ void onImGuiRender() {
 	showArchive();
 	showWatchedVars();
 	_state->_logger->draw("Logger", &_state->_w.logger);
+	ImGuiEx::drawProfiler("Profiler", &_state->_w.profiler);
 }
 
 void onImGuiCleanup() {
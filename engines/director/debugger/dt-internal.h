@@ -31,6 +31,7 @@
 #include "backends/imgui/imgui.h"
 #include "backends/imgui/imgui_fonts.h"
 #include "backends/imgui/components/imgui_logger.h"
+#include "backends/imgui/components/imgui_profiler.h"
 
 #include "director/debugger/imgui_memory_editor.h"
 
@@ -95,6 +96,7 @@ typedef struct ImGuiWindows {
 	bool logger = false;
 	bool archive = false;
 	bool watchedVars = false;
+	bool profiler = false;
 } ImGuiWindows;
 
 typedef struct ImGuiState {
@@ -25,6 +25,7 @@
 #include "common/file.h"
 #include "common/rational.h"
 #include "common/memstream.h"
+#include "common/profiler.h"
 #include "common/punycode.h"
 #include "common/substream.h"
 
@@ -753,6 +754,7 @@ void Score::update() {
 }
 
 void Score::renderFrame(uint16 frameId, RenderMode mode) {
+	PROFILE_ZONE("Score::renderFrame");
 	uint32 start = g_system->getMillis(false);
 	// Force cursor update if a new movie's started.
 	if (_window->_newMovieStarted)
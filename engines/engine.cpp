@@ -215,6 +215,9 @@ Engine::~Engine() {
 	Common::Event evt;
 	while (g_system->getEventManager()->pollEvent(evt)) {}
 
+	// Nothing polls the background saves once the engine is gone
+	_saveFileMan->finishBackgroundSaves();
+
 	delete _debugger;
 	delete _mainMenuDialog;
 	g_engine = NULL;
@@ -626,6 +629,8 @@ void Engine::warnMissingExtractedCDAudio() {
 }
 
 void Engine::handleAutoSave() {
+	_saveFileMan->pollBackgroundSaves();
+
 #ifdef ENABLE_EVENTRECORDER
 	if (!g_eventRec.processAutosave())
 		return;
@@ -939,6 +944,22 @@ bool Engine::canLoadGameStateCurrently(Common::U32String *msg) {
 }
 
 Common::Error Engine::saveGameState(int slot, const Common::String &desc, bool isAutosave) {
+	if (isAutosave) {
+		// Only serialize the game here, the save file manager compresses
+		// and writes the autosave without interrupting the game
+		Common::MemoryWriteStreamDynamic *buffer = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+		Common::Error result = saveGameStream(buffer, isAutosave);
+		if (result.getCode() != Common::kNoError) {
+			delete buffer;
+			return result;
+		}
+
+		getMetaEngine()->appendExtendedSaveToStream(buffer, getTotalPlayTime(), desc, isAutosave);
+		if (!_saveFileMan->saveInBackground(getSaveStateName(slot), buffer))
+			return Common::kWritingFailed;
+		return result;
+	}
+
 	Common::OutSaveFile *saveFile = _saveFileMan->openForSaving(getSaveStateName(slot));
 
 	if (!saveFile)
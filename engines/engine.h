@@ -469,6 +469,8 @@ public:
 	 * @param slot        The slot into which the save state should be stored.
 	 * @param desc        Description for the save state, entered by the user.
 	 * @param isAutosave  Expected to be true if an autosave is being created.
+	 *                    The default implementation then writes the save in
+	 *                    the background, see SaveFileManager::saveInBackground().
 	 *
 	 * @return kNoError on success, otherwise an error code.
 	 */
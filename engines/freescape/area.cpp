@@ -32,6 +32,42 @@
 
 namespace Freescape {
 
+// Half angle of a cone enclosing the view frustum, with some slack
+static const float kViewConeCos = 0.5f;
+static const float kViewConeSin = 0.866f;
+
+static bool isInViewCone(const Math::AABB &boundingBox, const Math::Vector3d &camera, const Math::Vector3d &direction) {
+	if (!boundingBox.isValid())
+		return true;
+
+	Math::Vector3d center = (boundingBox.getMin() + boundingBox.getMax()) / 2;
+	float radius = (boundingBox.getMax() - boundingBox.getMin()).length() / 2;
+
+	// Move the apex back so that the cone contains the whole bounding sphere
+	Math::Vector3d apex = camera - (radius / kViewConeSin) * direction;
+	Math::Vector3d distance = center - apex;
+	if (direction.dotProduct(distance) < distance.length() * kViewConeCos)
+		return false;
+
+	// The sphere can still be behind the camera
+	distance = center - camera;
+	if (-direction.dotProduct(distance) >= distance.length() * kViewConeSin)
+		return distance.length() <= radius;
+
+	return true;
+}
+
+static Math::AABB createSweptAABB(const Math::AABB &boundingBox, const Math::Vector3d &direction) {
+	// Small margin so objects touching the swept volume are tested as well
+	Math::Vector3d margin(1, 1, 1);
+	Math::AABB swept;
+	swept.expand(boundingBox.getMin() - margin);
+	swept.expand(boundingBox.getMax() + margin);
+	swept.expand(boundingBox.getMin() + direction - margin);
+	swept.expand(boundingBox.getMax() + direction + margin);
+	return swept;
+}
+
 Object *Area::objectWithIDFromMap(ObjectMap *map, uint16 objectID) {
 	if (!map)
 		return nullptr;
@@ -154,6 +190,7 @@ void Area::loadObjects(Common::SeekableReadStream *stream, Area *global) {
 		obj->setObjectFlags(flags);
 		obj->setOrigin(Math::Vector3d(x, y, z));
 	}
+	_spatialIndex.clear();
 
 	_colorRemaps.clear();
 	int colorRemapsSize = stream->readUint32LE();
@@ -234,8 +271,16 @@ void Area::resetArea() {
 }
 
 
+void Area::queryObjects(const Math::AABB &boundingBox, ObjectArray &objects) {
+	if (!_spatialIndex.isBuilt())
+		_spatialIndex.build(_drawableObjects);
+
+	_spatialIndex.query(boundingBox, objects);
+}
+
 void Area::draw(Freescape::Renderer *gfx, uint32 animationTicks, Math::Vector3d camera, Math::Vector3d direction) {
 	bool runAnimation = animationTicks != _lastTick;
+	direction.normalize();
 	assert(_drawableObjects.size() > 0);
 	ObjectArray planarObjects;
 	ObjectArray nonPlanarObjects;
@@ -359,12 +404,15 @@ void Area::draw(Freescape::Renderer *gfx, uint32 animationTicks, Math::Vector3d
 		}
 	}
 
+	// Offsets are computed using every object, only the drawing is culled
 	for (auto &obj : nonPlanarObjects) {
-		obj->draw(gfx);
+		if (isInViewCone(obj->_boundingBox, camera, direction))
+			obj->draw(gfx);
 	}
 
 	for (auto &pair : offsetMap) {
-		pair._key->draw(gfx, pair._value);
+		if (isInViewCone(pair._key->_boundingBox, camera, direction))
+			pair._key->draw(gfx, pair._value);
 	}
 
 	_lastTick = animationTicks;
@@ -395,7 +443,9 @@ Object *Area::checkCollisionRay(const Math::Ray &ray, int raySize) {
 	float size = 16.0 * 8192.0; // TODO: check if this is the max size
 	Math::AABB boundingBox(ray.getOrigin(), ray.getOrigin());
 	Object *collided = nullptr;
-	for (auto &obj : _drawableObjects) {
+	ObjectArray objects;
+	queryObjects(createSweptAABB(boundingBox, raySize * ray.getDirection()), objects);
+	for (auto &obj : objects) {
 		if (obj->getType() == kLineType)
 			// If the line is not along an axis, the AABB is wildly inaccurate so we skip it
 			if (((GeometricObject *)obj)->isLineButNotStraight())
@@ -424,7 +474,9 @@ Object *Area::checkCollisionRay(const Math::Ray &ray, int raySize) {
 
 ObjectArray Area::checkCollisions(const Math::AABB &boundingBox) {
 	ObjectArray collided;
-	for (auto &obj : _drawableObjects) {
+	ObjectArray objects;
+	queryObjects(boundingBox, objects);
+	for (auto &obj : objects) {
 		if (!obj->isDestroyed() && !obj->isInvisible()) {
 			GeometricObject *gobj = (GeometricObject *)obj;
 			if (gobj->collides(boundingBox)) {
@@ -436,7 +488,9 @@ ObjectArray Area::checkCollisions(const Math::AABB &boundingBox) {
 }
 
 bool Area::checkIfPlayerWasCrushed(const Math::AABB &boundingBox) {
-	for (auto &obj : _drawableObjects) {
+	ObjectArray objects;
+	queryObjects(boundingBox, objects);
+	for (auto &obj : objects) {
 		if (!obj->isDestroyed() && !obj->isInvisible() && obj->getType() == kGroupType) {
 			Group *group = (Group *)obj;
 			if (group->collides(boundingBox)) {
@@ -450,7 +504,13 @@ bool Area::checkIfPlayerWasCrushed(const Math::AABB &boundingBox) {
 Math::Vector3d Area::separateFromWall(const Math::Vector3d &_position) {
 	Math::Vector3d position = _position;
 	float sep = 8 / _scale;
-	for (auto &obj : _drawableObjects) {
+	Math::AABB boundingBox;
+	boundingBox.expand(position - Math::Vector3d(sep, sep, sep));
+	boundingBox.expand(position + Math::Vector3d(sep, sep, sep));
+
+	ObjectArray objects;
+	queryObjects(boundingBox, objects);
+	for (auto &obj : objects) {
 		if (!obj->isDestroyed() && !obj->isInvisible()) {
 			GeometricObject *gobj = (GeometricObject *)obj;
 			Math::Vector3d distance = gobj->_boundingBox.distance(position);
@@ -501,12 +561,14 @@ Math::Vector3d Area::resolveCollisions(const Math::Vector3d &lastPosition_, cons
 
 	float epsilon = 1.5;
 	int i = 0;
+	ObjectArray objects;
 	while (true) {
 		float distance = 1.0;
 		Math::Vector3d normal;
 		Math::Vector3d direction = position - lastPosition;
 
-		for (auto &obj : _drawableObjects) {
+		queryObjects(createSweptAABB(boundingBox, direction), objects);
+		for (auto &obj : objects) {
 			if (!obj->isDestroyed() && !obj->isInvisible()) {
 				GeometricObject *gobj = (GeometricObject *)obj;
 				Math::Vector3d collidedNormal;
@@ -539,11 +601,13 @@ bool Area::checkInSight(const Math::Ray &ray, float maxDistance) {
 			FCLInstructionVector(),
 			"");
 
+	ObjectArray objects;
 	for (int distanceMultiplier = 2; distanceMultiplier <= 10; distanceMultiplier++) {
 		Math::Vector3d origin = ray.getOrigin() + distanceMultiplier * (maxDistance / 10) * direction;
 		point.setOrigin(origin);
 
-		for (auto &obj : _drawableObjects) {
+		queryObjects(point._boundingBox, objects);
+		for (auto &obj : objects) {
 			if (obj->getType() != kSensorType && !obj->isDestroyed() && !obj->isInvisible() && obj->_boundingBox.isValid() && point.collides(obj->_boundingBox)) {
 				return false;
 			}
@@ -563,6 +627,7 @@ void Area::addObject(Object *obj) {
 		_drawableObjects.insert_at(0, obj);
 
 	_addedObjects[id] = obj;
+	_spatialIndex.clear();
 }
 
 void Area::removeObject(int16 id) {
@@ -575,6 +640,7 @@ void Area::removeObject(int16 id) {
 	}
 	_objectsByID->erase(id);
 	_addedObjects.erase(id);
+	_spatialIndex.clear();
 }
 
 Common::List<int> Area::getEntranceIds() {
@@ -604,6 +670,7 @@ void Area::addObjectFromArea(int16 id, Area *global) {
 			_drawableObjects.insert_at(0, obj);
 		}
 	}
+	_spatialIndex.clear();
 }
 
 void Area::addGroupFromArea(int16 id, Area *global) {
@@ -624,6 +691,8 @@ void Area::addGroupFromArea(int16 id, Area *global) {
 			addObjectFromArea(it, global);
 		group->linkObject(objectWithID(it));
 	}
+	// Linked objects are now moved by the group
+	_spatialIndex.clear();
 }
 
 
@@ -647,6 +716,7 @@ void Area::addFloor() {
 		FCLInstructionVector());
 	(*_objectsByID)[id] = obj;
 	_drawableObjects.insert_at(0, obj);
+	_spatialIndex.clear();
 }
 
 void Area::addStructure(Area *global) {
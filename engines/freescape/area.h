@@ -31,12 +31,12 @@
 #include "freescape/language/instruction.h"
 #include "freescape/objects/object.h"
 #include "freescape/objects/group.h"
+#include "freescape/spatialindex.h"
 
 
 namespace Freescape {
 
 typedef Common::HashMap<uint16, Object *> ObjectMap;
-typedef Common::Array<Object *> ObjectArray;
 class Area {
 public:
 	Area(uint16 areaID, uint16 areaFlags, ObjectMap *objectsByID, ObjectMap *entrancesByID);
@@ -106,6 +106,9 @@ private:
 	ObjectArray _drawableObjects;
 	ObjectMap _addedObjects;
 	Object *objectWithIDFromMap(ObjectMap *map, uint16 objectID);
+
+	SpatialIndex _spatialIndex;
+	void queryObjects(const Math::AABB &boundingBox, ObjectArray &objects);
 };
 
 } // End of namespace Freescape
@@ -48,6 +48,7 @@ MODULE_OBJS := \
 	objects/sensor.o \
 	sweepAABB.o \
 	sound.o \
+	spatialindex.o \
 	ui.o \
 	unpack.o
 
@@ -22,6 +22,7 @@
 #include "common/file.h"
 #include "audio/audiostream.h"
 #include "audio/decoders/raw.h"
+#include "audio/samplecache.h"
 
 #include "freescape/freescape.h"
 #include "freescape/games/eclipse/eclipse.h"
@@ -399,13 +400,17 @@ void FreescapeEngine::playSound(int index, bool sync) {
 	_syncSound = sync;
 }
 void FreescapeEngine::playWav(const Common::Path &filename) {
-
-	Common::SeekableReadStream *s = _dataBundle->createReadStreamForMember(filename);
-	if (!s) {
-		debugC(1, kFreescapeDebugMedia, "WARNING: Sound %s not found", filename.toString().c_str());
-		return;
+	// Sounds are played often, so keep them decoded instead of extracting
+	// them from the bundle again every time
+	Audio::AudioStream *stream = Audio::SampleCache::instance().getStream(filename.toString());
+	if (!stream) {
+		Common::SeekableReadStream *s = _dataBundle->createReadStreamForMember(filename);
+		if (!s) {
+			debugC(1, kFreescapeDebugMedia, "WARNING: Sound %s not found", filename.toString().c_str());
+			return;
+		}
+		stream = Audio::SampleCache::instance().addStream(filename.toString(), Audio::makeWAVStream(s, DisposeAfterUse::YES));
 	}
-	Audio::AudioStream *stream = Audio::makeWAVStream(s, DisposeAfterUse::YES);
 	_mixer->playStream(Audio::Mixer::kSFXSoundType, &_soundFxHandle, stream);
 }
 
@@ -0,0 +1,152 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/algorithm.h"
+
+#include "freescape/spatialindex.h"
+
+namespace Freescape {
+
+// Object coordinates are stored as 8-bit values multiplied by 32
+static const float kWorldLimit = 256 * 32;
+
+static bool isIndexable(Object *obj) {
+	if (obj->getType() == kGroupType || obj->_partOfGroup)
+		return false;
+
+	if (!obj->_boundingBox.isValid())
+		return false;
+
+	Math::Vector3d min = obj->_boundingBox.getMin();
+	Math::Vector3d max = obj->_boundingBox.getMax();
+	return min.x() >= -kWorldLimit && min.z() >= -kWorldLimit && max.x() <= kWorldLimit && max.z() <= kWorldLimit;
+}
+
+SpatialIndex::SpatialIndex() :
+	_minX(0), _minZ(0), _cellSizeX(1), _cellSizeZ(1), _stamp(0), _built(false) {
+}
+
+void SpatialIndex::clear() {
+	_objects.clear();
+	_stamps.clear();
+	_unindexed.clear();
+	for (int i = 0; i < kGridSize * kGridSize; i++)
+		_cells[i].clear();
+	_built = false;
+}
+
+void SpatialIndex::build(const ObjectArray &objects) {
+	clear();
+	_objects = objects;
+	_stamps.resize(_objects.size());
+	for (uint i = 0; i < _stamps.size(); i++)
+		_stamps[i] = 0;
+	_stamp = 0;
+
+	Math::AABB bounds;
+	for (auto &obj : _objects) {
+		if (isIndexable(obj)) {
+			bounds.expand(obj->_boundingBox.getMin());
+			bounds.expand(obj->_boundingBox.getMax());
+		}
+	}
+
+	if (bounds.isValid()) {
+		_minX = bounds.getMin().x();
+		_minZ = bounds.getMin().z();
+		_cellSizeX = MAX((bounds.getMax().x() - _minX) / kGridSize, 1.0f);
+		_cellSizeZ = MAX((bounds.getMax().z() - _minZ) / kGridSize, 1.0f);
+	}
+
+	for (uint i = 0; i < _objects.size(); i++) {
+		int minX, minZ, maxX, maxZ;
+		if (!isIndexable(_objects[i]) || !cellRange(_objects[i]->_boundingBox, minX, minZ, maxX, maxZ) ||
+			(maxX - minX + 1) * (maxZ - minZ + 1) > kMaxCellsPerObject) {
+			_unindexed.push_back(i);
+			continue;
+		}
+
+		for (int z = minZ; z <= maxZ; z++)
+			for (int x = minX; x <= maxX; x++)
+				_cells[z * kGridSize + x].push_back(i);
+	}
+
+	_built = true;
+}
+
+bool SpatialIndex::cellRange(const Math::AABB &box, int &minX, int &minZ, int &maxX, int &maxZ) const {
+	float fMinX = floorf((box.getMin().x() - _minX) / _cellSizeX);
+	float fMinZ = floorf((box.getMin().z() - _minZ) / _cellSizeZ);
+	float fMaxX = floorf((box.getMax().x() - _minX) / _cellSizeX);
+	float fMaxZ = floorf((box.getMax().z() - _minZ) / _cellSizeZ);
+
+	// Every indexed object lies inside the grid, so a box outside of it cannot reach any
+	if (fMaxX < 0 || fMaxZ < 0 || fMinX >= kGridSize || fMinZ >= kGridSize)
+		return false;
+
+	minX = fMinX < 0 ? 0 : (int)fMinX;
+	minZ = fMinZ < 0 ? 0 : (int)fMinZ;
+	maxX = fMaxX >= kGridSize ? kGridSize - 1 : (int)fMaxX;
+	maxZ = fMaxZ >= kGridSize ? kGridSize - 1 : (int)fMaxZ;
+	return true;
+}
+
+void SpatialIndex::collect(uint index) {
+	if (_stamps[index] == _stamp)
+		return;
+
+	_stamps[index] = _stamp;
+	_found.push_back(index);
+}
+
+void SpatialIndex::query(const Math::AABB &box, ObjectArray &result) {
+	assert(_built);
+	if (!box.isValid()) {
+		result = _objects;
+		return;
+	}
+
+	_found.resize(0);
+	if (++_stamp == 0) {
+		for (uint i = 0; i < _stamps.size(); i++)
+			_stamps[i] = 0;
+		_stamp = 1;
+	}
+
+	for (auto &index : _unindexed)
+		collect(index);
+
+	int minX, minZ, maxX, maxZ;
+	if (cellRange(box, minX, minZ, maxX, maxZ)) {
+		for (int z = minZ; z <= maxZ; z++)
+			for (int x = minX; x <= maxX; x++)
+				for (auto &index : _cells[z * kGridSize + x])
+					collect(index);
+	}
+
+	Common::sort(_found.begin(), _found.end());
+
+	result.resize(0);
+	for (auto &index : _found)
+		result.push_back(_objects[index]);
+}
+
+} // End of namespace Freescape
@@ -0,0 +1,76 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef FREESCAPE_SPATIALINDEX_H
+#define FREESCAPE_SPATIALINDEX_H
+
+#include "math/aabb.h"
+
+#include "freescape/objects/object.h"
+
+namespace Freescape {
+
+typedef Common::Array<Object *> ObjectArray;
+
+/**
+ * Uniform grid over the horizontal plane of an area, used to avoid
+ * testing every object of the area during collision and sight queries.
+ *
+ * Objects that can move on their own (groups and the objects they animate),
+ * as well as objects too large to be usefully bucketed (like the floor),
+ * are not stored in the grid and are returned by every query.
+ */
+class SpatialIndex {
+public:
+	SpatialIndex();
+
+	void build(const ObjectArray &objects);
+	void clear();
+	bool isBuilt() const { return _built; }
+
+	/**
+	 * Collect the objects whose bounding box may intersect the given box.
+	 * Objects are returned in the order they were passed to build().
+	 */
+	void query(const Math::AABB &box, ObjectArray &result);
+
+private:
+	static const int kGridSize = 16;
+	static const int kMaxCellsPerObject = kGridSize * kGridSize / 4;
+
+	bool cellRange(const Math::AABB &box, int &minX, int &minZ, int &maxX, int &maxZ) const;
+	void collect(uint index);
+
+	ObjectArray _objects;
+	Common::Array<uint32> _stamps;
+	Common::Array<uint> _unindexed;
+	Common::Array<uint> _cells[kGridSize * kGridSize];
+	Common::Array<uint> _found;
+
+	float _minX, _minZ;
+	float _cellSizeX, _cellSizeZ;
+	uint32 _stamp;
+	bool _built;
+};
+
+} // End of namespace Freescape
+
+#endif // FREESCAPE_SPATIALINDEX_H
@@ -48,44 +48,59 @@ void Glulx::execute_loop() {
 		/* Stash the current opcode's address, in case the interpreter needs to serialize the VM state out-of-band. */
 		prevpc = pc;
 
-		/* Fetch the opcode number. */
-		opcode = Mem1(pc);
-		pc++;
-		if (opcode & 0x80) {
-			/* More than one-byte opcode. */
-			if (opcode & 0x40) {
-				/* Four-byte opcode */
-				opcode &= 0x3F;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-			} else {
-				/* Two-byte opcode */
-				opcode &= 0x7F;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
+		if (pc < ramstart && decodecache) {
+			/* Code in ROM can't change, so its decoded form is reused every time
+			   the instruction is executed. */
+			decodedinst_t *decoded = &decodecache[pc & (DECODECACHE_SIZE - 1)];
+			if (decoded->addr != pc) {
+				decode_instruction(decoded, pc);
+				decoded->addr = pc;
+			}
+
+			opcode = decoded->opcode;
+			pc = decoded->nextpc;
+			load_decoded_operands(inst, decoded);
+		} else {
+
+			/* Fetch the opcode number. */
+			opcode = Mem1(pc);
+			pc++;
+			if (opcode & 0x80) {
+				/* More than one-byte opcode. */
+				if (opcode & 0x40) {
+					/* Four-byte opcode */
+					opcode &= 0x3F;
+					opcode = (opcode << 8) | Mem1(pc);
+					pc++;
+					opcode = (opcode << 8) | Mem1(pc);
+					pc++;
+					opcode = (opcode << 8) | Mem1(pc);
+					pc++;
+				} else {
+					/* Two-byte opcode */
+					opcode &= 0x7F;
+					opcode = (opcode << 8) | Mem1(pc);
+					pc++;
+				}
 			}
-		}
 
-		/* Now we have an opcode number. */
+			/* Now we have an opcode number. */
 
-		/* Fetch the structure that describes how the operands for this
-		   opcode are arranged. This is a pointer to an immutable,
-		   static object. */
-		if (opcode < 0x80)
-			oplist = fast_operandlist[opcode];
-		else
-			oplist = lookup_operandlist(opcode);
+			/* Fetch the structure that describes how the operands for this
+			   opcode are arranged. This is a pointer to an immutable,
+			   static object. */
+			if (opcode < 0x80)
+				oplist = fast_operandlist[opcode];
+			else
+				oplist = lookup_operandlist(opcode);
 
-		if (!oplist)
-			fatal_error_i("Encountered unknown opcode.", opcode);
+			if (!oplist)
+				fatal_error_i("Encountered unknown opcode.", opcode);
 
-		/* Based on the oplist structure, load the actual operand values
-		   into inst. This moves the PC up to the end of the instruction. */
-		parse_operands(inst, oplist);
+			/* Based on the oplist structure, load the actual operand values
+			   into inst. This moves the PC up to the end of the instruction. */
+			parse_operands(inst, oplist);
+		}
 
 		/* Perform the opcode. This switch statement is split in two, based
 		   on some paranoid suspicions about the ability of compilers to
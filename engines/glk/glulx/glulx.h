@@ -145,6 +145,12 @@ private:
 	 */
 	const operandlist_t *fast_operandlist[0x80];
 
+	/**
+	 * Direct-mapped cache of decoded instructions, indexed by the low bits of their address.
+	 * Only code in ROM is cached, since it can never be modified while the game runs.
+	 */
+	decodedinst_t *decodecache;
+
 	/**@}*/
 
 	/**
@@ -182,6 +188,13 @@ private:
 	bool tablecache_valid;
 	cacheblock_t tablecache;
 
+	/**
+	 * Decoding caches of the string tables used so far. Only tables entirely in ROM are
+	 * cached, so these stay valid until the VM shuts down.
+	 */
+	tablecacheentry_t tablecaches[TABLECACHE_COUNT];
+	uint tablecache_next;
+
 	/* This misbehaves if a Glk function has more than one S argument. */
 #define STATIC_TEMP_BUFSIZE (127)
 	char temp_buf[STATIC_TEMP_BUFSIZE + 1];
@@ -388,6 +401,7 @@ protected:
 	void glkio_unichar_nouni_han(uint32 val);
 
 	void dropcache(cacheblock_t *cablist);
+	void dropcaches();
 	void buildcache(cacheblock_t *cablist, uint nodeaddr, int depth, int mask);
 	void dumpcache(cacheblock_t *cablist, int count, int indent);
 
@@ -536,6 +550,12 @@ public:
 	 */
 	void init_operands();
 
+	/**
+	 * Allocate the decoded instruction cache. This is called when the VM is set up; if the
+	 * allocation fails, instructions are simply decoded every time they are executed.
+	 */
+	void init_decodecache();
+
 	/**
 	 * Return the operandlist for a given opcode. For opcodes in the range 00..7F, it's faster
 	 * to use the array fast_operandlist[].
@@ -551,6 +571,19 @@ public:
 	*/
 	void parse_operands(oparg_t *opargs, const operandlist_t *oplist);
 
+	/**
+	 * Decode the instruction at addr, which must be in ROM, into the given cache slot.
+	 * This does everything that the main loop and parse_operands() do with the
+	 * instruction bytes, but doesn't touch the PC, the stack or memory.
+	 */
+	void decode_instruction(decodedinst_t *inst, uint addr);
+
+	/**
+	 * Load the operand values of a decoded instruction into args. This is the equivalent
+	 * of parse_operands() for instructions from the decoded instruction cache.
+	 */
+	void load_decoded_operands(oparg_t *opargs, const decodedinst_t *inst);
+
 	/**
 	 * Store a result value, according to the desttype and destaddress given. This is usually used to store
 	 * the result of an opcode, but it's also used by any code that pulls a call-stub off the stack.
@@ -351,6 +351,33 @@ typedef oparg_struct oparg_t;
 
 #define MAX_OPERANDS (8)
 
+/**
+ * Number of slots in the decoded instruction cache. Must be a power of two.
+ */
+#define DECODECACHE_SIZE (0x2000)
+
+/**
+ * An instruction in ROM whose opcode and operand addressing modes have already been
+ * decoded. The operand modes are normalized so that constants, RAM-relative addresses
+ * and the different operand widths don't need to be handled again at execution time.
+ */
+struct decodedinst_struct {
+	uint addr;                      ///< Address of the instruction, or 0 for an unused slot
+	uint opcode;
+	uint nextpc;                    ///< Address of the following instruction
+	const operandlist_t *oplist;
+	byte modes[MAX_OPERANDS];       ///< One of the decodedmode values
+	uint values[MAX_OPERANDS];      ///< Constant value, or main memory/locals address
+};
+typedef decodedinst_struct decodedinst_t;
+
+enum decodedmode {
+	decodedmode_Constant = 0,       ///< Load a constant, or discard a stored value
+	decodedmode_Memory = 1,         ///< Main memory address
+	decodedmode_Locals = 2,         ///< Address relative to the locals segment
+	decodedmode_Stack = 3           ///< Pop a loaded value, or push a stored one
+};
+
 typedef uint(Glulx::*acceleration_func)(uint argc, uint *argv);
 
 struct accelentry_struct {
@@ -417,6 +444,18 @@ struct cacheblock_struct {
 };
 typedef cacheblock_struct cacheblock_t;
 
+/**
+ * Number of string-decoding tables whose caches are kept around. Games which switch
+ * between a few tables with @setstringtbl don't have to rebuild the cache each time.
+ */
+#define TABLECACHE_COUNT (4)
+
+struct tablecacheentry_struct {
+	uint addr;              ///< Address of the string table, or 0 for an unused entry
+	cacheblock_t cache;
+};
+typedef tablecacheentry_struct tablecacheentry_t;
+
 } // End of namespace Glulx
 } // End of namespace Glk
 
@@ -68,6 +68,15 @@ void Glulx::init_operands() {
 		fast_operandlist[ix] = lookup_operandlist(ix);
 }
 
+void Glulx::init_decodecache() {
+	if (!decodecache)
+		decodecache = (decodedinst_t *)glulx_malloc(sizeof(decodedinst_t) * DECODECACHE_SIZE);
+	if (decodecache) {
+		for (int ix = 0; ix < DECODECACHE_SIZE; ix++)
+			decodecache[ix].addr = 0;
+	}
+}
+
 const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
 	switch (opcode) {
 	case op_nop:
@@ -516,6 +525,222 @@ WrLocalsAddr:
 	}
 }
 
+void Glulx::decode_instruction(decodedinst_t *inst, uint addr) {
+	int ix;
+	uint opcode;
+	const operandlist_t *oplist;
+	uint modeaddr;
+	int modeval = 0;
+
+	/* Fetch the opcode number, exactly as execute_loop() does. */
+	opcode = Mem1(addr);
+	addr++;
+	if (opcode & 0x80) {
+		if (opcode & 0x40) {
+			opcode &= 0x3F;
+			opcode = (opcode << 8) | Mem1(addr);
+			opcode = (opcode << 8) | Mem1(addr + 1);
+			opcode = (opcode << 8) | Mem1(addr + 2);
+			addr += 3;
+		} else {
+			opcode &= 0x7F;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+		}
+	}
+
+	if (opcode < 0x80)
+		oplist = fast_operandlist[opcode];
+	else
+		oplist = lookup_operandlist(opcode);
+
+	if (!oplist)
+		fatal_error_i("Encountered unknown opcode.", opcode);
+
+	inst->opcode = opcode;
+	inst->oplist = oplist;
+
+	/* Walk the operands the same way parse_operands() does, but only record
+	   where each value comes from. */
+	modeaddr = addr;
+	addr += (oplist->num_ops + 1) / 2;
+
+	for (ix = 0; ix < oplist->num_ops; ix++) {
+		int mode;
+		uint value = 0;
+		byte decoded;
+
+		if ((ix & 1) == 0) {
+			modeval = Mem1(modeaddr);
+			mode = (modeval & 0x0F);
+		} else {
+			mode = ((modeval >> 4) & 0x0F);
+			modeaddr++;
+		}
+
+		switch (mode) {
+		case 0: /* constant zero, or discard value */
+			decoded = decodedmode_Constant;
+			break;
+
+		case 1: /* one-byte constant */
+			decoded = decodedmode_Constant;
+			value = (int)(signed char)(Mem1(addr));
+			addr++;
+			break;
+
+		case 2: /* two-byte constant */
+			decoded = decodedmode_Constant;
+			value = (int)(signed char)(Mem1(addr));
+			value = (value << 8) | (uint)(Mem1(addr + 1));
+			addr += 2;
+			break;
+
+		case 3: /* four-byte constant */
+			decoded = decodedmode_Constant;
+			value = Mem4(addr);
+			addr += 4;
+			break;
+
+		case 5: /* main memory */
+		case 13:
+			decoded = decodedmode_Memory;
+			value = (uint)(Mem1(addr));
+			addr++;
+			break;
+
+		case 6:
+		case 14:
+			decoded = decodedmode_Memory;
+			value = (uint)Mem2(addr);
+			addr += 2;
+			break;
+
+		case 7:
+		case 15:
+			decoded = decodedmode_Memory;
+			value = Mem4(addr);
+			addr += 4;
+			break;
+
+		case 8: /* stack */
+			decoded = decodedmode_Stack;
+			break;
+
+		case 9: /* locals */
+			decoded = decodedmode_Locals;
+			value = (uint)(Mem1(addr));
+			addr++;
+			break;
+
+		case 10:
+			decoded = decodedmode_Locals;
+			value = (uint)Mem2(addr);
+			addr += 2;
+			break;
+
+		case 11:
+			decoded = decodedmode_Locals;
+			value = Mem4(addr);
+			addr += 4;
+			break;
+
+		default:
+			decoded = decodedmode_Constant;
+			if (oplist->formlist[ix] == modeform_Load)
+				fatal_error("Unknown addressing mode in load operand.");
+			else
+				fatal_error("Unknown addressing mode in store operand.");
+		}
+
+		/* Modes 13-15 are relative to the start of RAM. */
+		if (mode >= 13)
+			value += ramstart;
+
+		if (oplist->formlist[ix] == modeform_Store && mode >= 1 && mode <= 3)
+			fatal_error("Constant addressing mode in store operand.");
+
+		inst->modes[ix] = decoded;
+		inst->values[ix] = value;
+	}
+
+	inst->nextpc = addr;
+}
+
+void Glulx::load_decoded_operands(oparg_t *args, const decodedinst_t *inst) {
+	const operandlist_t *oplist = inst->oplist;
+	int numops = oplist->num_ops;
+	int argsize = oplist->arg_size;
+	int ix;
+	oparg_t *curarg;
+
+	for (ix = 0, curarg = args; ix < numops; ix++, curarg++) {
+		uint addr = inst->values[ix];
+
+		if (oplist->formlist[ix] == modeform_Load) {
+			curarg->desttype = 0;
+
+			switch (inst->modes[ix]) {
+			case decodedmode_Constant:
+				curarg->value = addr;
+				break;
+
+			case decodedmode_Stack:
+				if (stackptr < valstackbase + 4) {
+					fatal_error("Stack underflow in operand.");
+				}
+				stackptr -= 4;
+				curarg->value = Stk4(stackptr);
+				break;
+
+			case decodedmode_Memory:
+				if (argsize == 4) {
+					curarg->value = Mem4(addr);
+				} else if (argsize == 2) {
+					curarg->value = Mem2(addr);
+				} else {
+					curarg->value = Mem1(addr);
+				}
+				break;
+
+			default: /* decodedmode_Locals */
+				addr += localsbase;
+				if (argsize == 4) {
+					curarg->value = Stk4(addr);
+				} else if (argsize == 2) {
+					curarg->value = Stk2(addr);
+				} else {
+					curarg->value = Stk1(addr);
+				}
+				break;
+			}
+
+		} else { /* modeform_Store */
+			switch (inst->modes[ix]) {
+			case decodedmode_Constant:
+				curarg->desttype = 0;
+				curarg->value = 0;
+				break;
+
+			case decodedmode_Stack:
+				curarg->desttype = 3;
+				curarg->value = 0;
+				break;
+
+			case decodedmode_Memory:
+				curarg->desttype = 1;
+				curarg->value = addr;
+				break;
+
+			default: /* decodedmode_Locals */
+				curarg->desttype = 2;
+				curarg->value = addr;
+				break;
+			}
+		}
+	}
+}
+
 void Glulx::store_operand(uint desttype, uint destaddr, uint storeval) {
 	switch (desttype) {
 
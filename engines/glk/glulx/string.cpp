@@ -615,16 +615,14 @@ uint Glulx::stream_get_table() {
 }
 
 void Glulx::stream_set_table(uint addr) {
+	int ix;
+
 	if (stringtable == addr)
 		return;
 
-	/* Drop cache. */
-	if (tablecache_valid) {
-		if (tablecache.type == 0)
-			dropcache(tablecache.u.branches);
-		tablecache.u.branches = nullptr;
-		tablecache_valid = false;
-	}
+	/* Stop using the current cache. It stays in tablecaches[] in case the
+	   game switches back to this table later. */
+	tablecache_valid = false;
 
 	stringtable = addr;
 
@@ -636,13 +634,48 @@ void Glulx::stream_set_table(uint addr) {
 		/* cache_stringtable = true; ...for testing only */
 		/* cache_stringtable = false; ...for testing only */
 		if (cache_stringtable) {
-			buildcache(&tablecache, rootaddr, CACHEBITS, 0);
-			/* dumpcache(&tablecache, 1, 0); */
+			tablecacheentry_t *entry = nullptr;
+			for (ix = 0; ix < TABLECACHE_COUNT; ix++) {
+				if (tablecaches[ix].addr == stringtable) {
+					entry = &tablecaches[ix];
+					break;
+				}
+			}
+
+			if (!entry) {
+				/* Not decoded yet; replace the oldest entry. */
+				entry = &tablecaches[tablecache_next];
+				tablecache_next = (tablecache_next + 1) % TABLECACHE_COUNT;
+				if (entry->addr && entry->cache.type == 0)
+					dropcache(entry->cache.u.branches);
+
+				entry->addr = stringtable;
+				buildcache(&entry->cache, rootaddr, CACHEBITS, 0);
+				/* dumpcache(&entry->cache, 1, 0); */
+			}
+
+			tablecache = entry->cache;
 			tablecache_valid = true;
 		}
 	}
 }
 
+void Glulx::dropcaches() {
+	int ix;
+
+	stream_set_table(0);
+
+	for (ix = 0; ix < TABLECACHE_COUNT; ix++) {
+		tablecacheentry_t *entry = &tablecaches[ix];
+		if (entry->addr && entry->cache.type == 0)
+			dropcache(entry->cache.u.branches);
+		entry->addr = 0;
+		entry->cache.u.branches = nullptr;
+	}
+	tablecache_next = 0;
+	tablecache.u.branches = nullptr;
+}
+
 void Glulx::buildcache(cacheblock_t *cablist, uint nodeaddr, int depth, int mask) {
 	int ix, type;
 
@@ -89,6 +89,7 @@ void Glulx::setup_vm() {
 
 	// Initialize various other things in the terp.
 	init_operands();
+	init_decodecache();
 	init_serial();
 
 	// Set up the initial machine state.
@@ -104,7 +105,12 @@ void Glulx::setup_vm() {
 }
 
 void Glulx::finalize_vm() {
-	stream_set_table(0);
+	dropcaches();
+
+	if (decodecache) {
+		glulx_free(decodecache);
+		decodecache = nullptr;
+	}
 
 	if (memmap) {
 		glulx_free(memmap);
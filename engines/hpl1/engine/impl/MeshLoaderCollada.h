@@ -29,6 +29,7 @@
 #define HPL_MESH_LOADER_COLLADA_H
 
 #include "common/list.h"
+#include "common/path.h"
 #include "hpl1/engine/graphics/VertexBuffer.h"
 #include "hpl1/engine/math/MathTypes.h"
 #include "hpl1/engine/physics/PhysicsJoint.h"
@@ -497,25 +498,25 @@ private:
 						cColladaScene *apColladaScene,
 						bool abCache);
 
-	bool SaveStructures(const tString &asFile,
-						tColladaImageVec *apColladaImageVec,
-						tColladaTextureVec *apColladaTextureVec,
-						tColladaMaterialVec *apColladaMaterialVec,
-						tColladaLightVec *apColladaLightVec,
-						tColladaGeometryVec *apColladaGeometryVec,
-						tColladaControllerVec *apColladaControllerVec,
-						tColladaAnimationVec *apColladaAnimVec,
-						cColladaScene *apColladaScene);
-
-	bool LoadStructures(const tString &asFile,
-						tColladaImageVec *apColladaImageVec,
-						tColladaTextureVec *apColladaTextureVec,
-						tColladaMaterialVec *apColladaMaterialVec,
-						tColladaLightVec *apColladaLightVec,
-						tColladaGeometryVec *apColladaGeometryVec,
-						tColladaControllerVec *apColladaControllerVec,
-						tColladaAnimationVec *apColladaAnimVec,
-						cColladaScene *apColladaScene);
+	bool SaveBinaryCache(const Common::Path &acCacheFile, uint32 alSourceSize, uint32 alSourceHash,
+						 tColladaImageVec *apColladaImageVec,
+						 tColladaTextureVec *apColladaTextureVec,
+						 tColladaMaterialVec *apColladaMaterialVec,
+						 tColladaLightVec *apColladaLightVec,
+						 tColladaGeometryVec *apColladaGeometryVec,
+						 tColladaControllerVec *apColladaControllerVec,
+						 tColladaAnimationVec *apColladaAnimVec,
+						 cColladaScene *apColladaScene);
+
+	bool LoadBinaryCache(const Common::Path &acCacheFile, uint32 alSourceSize, uint32 alSourceHash,
+						 tColladaImageVec *apColladaImageVec,
+						 tColladaTextureVec *apColladaTextureVec,
+						 tColladaMaterialVec *apColladaMaterialVec,
+						 tColladaLightVec *apColladaLightVec,
+						 tColladaGeometryVec *apColladaGeometryVec,
+						 tColladaControllerVec *apColladaControllerVec,
+						 tColladaAnimationVec *apColladaAnimVec,
+						 cColladaScene *apColladaScene);
 
 	void LoadColladaScene(TiXmlElement *apRootElem, cColladaNode *apParentNode, cColladaScene *apScene,
 						  tColladaLightVec *apColladaLightVec);
@@ -0,0 +1,690 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "hpl1/engine/impl/MeshLoaderCollada.h"
+
+#include "hpl1/engine/system/low_level_system.h"
+
+#include "common/file.h"
+#include "common/fs.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+
+namespace hpl {
+
+//////////////////////////////////////////////////////////////////////////
+// BINARY CACHE
+//
+// The structures filled from a collada file are stored in the collada
+// subdirectory of the save path, so that following loads of an unchanged file skip the XML
+// parsing entirely. A cache is only used when its version, the set of
+// requested structures and the size and CRC32 of the source file match.
+//////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------
+
+static const uint32 kColladaCacheTag = MKTAG('H', 'C', 'O', 'L');
+static const uint32 kColladaCacheVersion = 1;
+
+enum eColladaCacheStructure {
+	eColladaCacheStructure_Images = 1 << 0,
+	eColladaCacheStructure_Textures = 1 << 1,
+	eColladaCacheStructure_Materials = 1 << 2,
+	eColladaCacheStructure_Lights = 1 << 3,
+	eColladaCacheStructure_Geometries = 1 << 4,
+	eColladaCacheStructure_Controllers = 1 << 5,
+	eColladaCacheStructure_Animations = 1 << 6,
+	eColladaCacheStructure_Scene = 1 << 7
+};
+
+static uint32 GetCacheStructureMask(tColladaImageVec *apColladaImageVec,
+									tColladaTextureVec *apColladaTextureVec,
+									tColladaMaterialVec *apColladaMaterialVec,
+									tColladaLightVec *apColladaLightVec,
+									tColladaGeometryVec *apColladaGeometryVec,
+									tColladaControllerVec *apColladaControllerVec,
+									tColladaAnimationVec *apColladaAnimVec,
+									cColladaScene *apColladaScene) {
+	uint32 lMask = 0;
+	if (apColladaImageVec)
+		lMask |= eColladaCacheStructure_Images;
+	if (apColladaTextureVec)
+		lMask |= eColladaCacheStructure_Textures;
+	if (apColladaMaterialVec)
+		lMask |= eColladaCacheStructure_Materials;
+	if (apColladaLightVec)
+		lMask |= eColladaCacheStructure_Lights;
+	if (apColladaGeometryVec)
+		lMask |= eColladaCacheStructure_Geometries;
+	if (apColladaControllerVec)
+		lMask |= eColladaCacheStructure_Controllers;
+	if (apColladaAnimVec)
+		lMask |= eColladaCacheStructure_Animations;
+	if (apColladaScene)
+		lMask |= eColladaCacheStructure_Scene;
+	return lMask;
+}
+
+//-----------------------------------------------------------------------
+
+static void WriteString(Common::WriteStream &aStream, const tString &asString) {
+	aStream.writeUint32LE(asString.size());
+	aStream.write(asString.c_str(), asString.size());
+}
+
+static void WriteVector3f(Common::WriteStream &aStream, const cVector3f &avVec) {
+	aStream.writeFloatLE(avVec.x);
+	aStream.writeFloatLE(avVec.y);
+	aStream.writeFloatLE(avVec.z);
+}
+
+static void WriteColor(Common::WriteStream &aStream, const cColor &aColor) {
+	aStream.writeFloatLE(aColor.r);
+	aStream.writeFloatLE(aColor.g);
+	aStream.writeFloatLE(aColor.b);
+	aStream.writeFloatLE(aColor.a);
+}
+
+static void WriteMatrix(Common::WriteStream &aStream, const cMatrixf &a_mtxMatrix) {
+	for (int i = 0; i < 16; ++i)
+		aStream.writeFloatLE(a_mtxMatrix.v[i]);
+}
+
+static void WriteFloatVec(Common::WriteStream &aStream, const tFloatVec &avVec) {
+	aStream.writeUint32LE(avVec.size());
+	for (size_t i = 0; i < avVec.size(); ++i)
+		aStream.writeFloatLE(avVec[i]);
+}
+
+//-----------------------------------------------------------------------
+
+// The cache file is read into memory in one go, so every count can be
+// checked against the bytes that are left before anything is allocated.
+class cColladaCacheReader {
+public:
+	cColladaCacheReader(Common::SeekableReadStream &aStream) : mStream(aStream), mbFailed(false) {}
+
+	bool Failed() const { return mbFailed || mStream.err(); }
+	void Fail() { mbFailed = true; }
+
+	uint32 ReadCount(uint32 alMinElementSize) {
+		uint32 lCount = mStream.readUint32LE();
+		if (Failed() || (int64)lCount * alMinElementSize > mStream.size() - mStream.pos()) {
+			mbFailed = true;
+			return 0;
+		}
+		return lCount;
+	}
+
+	int ReadInt() { return (int32)mStream.readUint32LE(); }
+	float ReadFloat() { return mStream.readFloatLE(); }
+	bool ReadBool() { return mStream.readByte() != 0; }
+
+	tString ReadString() {
+		uint32 lSize = ReadCount(1);
+		tString sRet;
+		if (lSize > 0) {
+			Common::Array<char> vBuffer;
+			vBuffer.resize(lSize);
+			mStream.read(&vBuffer[0], lSize);
+			sRet = tString(&vBuffer[0], lSize);
+		}
+		return sRet;
+	}
+
+	cVector3f ReadVector3f() {
+		cVector3f vVec;
+		vVec.x = ReadFloat();
+		vVec.y = ReadFloat();
+		vVec.z = ReadFloat();
+		return vVec;
+	}
+
+	cColor ReadColor() {
+		cColor color;
+		color.r = ReadFloat();
+		color.g = ReadFloat();
+		color.b = ReadFloat();
+		color.a = ReadFloat();
+		return color;
+	}
+
+	cMatrixf ReadMatrix() {
+		cMatrixf mtxMatrix;
+		for (int i = 0; i < 16; ++i)
+			mtxMatrix.v[i] = ReadFloat();
+		return mtxMatrix;
+	}
+
+	void ReadFloatVec(tFloatVec &avVec) {
+		uint32 lSize = ReadCount(4);
+		avVec.resize(lSize);
+		for (uint32 i = 0; i < lSize; ++i)
+			avVec[i] = ReadFloat();
+	}
+
+private:
+	Common::SeekableReadStream &mStream;
+	bool mbFailed;
+};
+
+//-----------------------------------------------------------------------
+
+static void SaveCacheNodes(Common::WriteStream &aStream, cColladaNode *apParentNode) {
+	aStream.writeUint32LE(apParentNode->mlstChildren.size());
+
+	for (tColladaNodeListIt it = apParentNode->mlstChildren.begin(); it != apParentNode->mlstChildren.end(); ++it) {
+		cColladaNode *pNode = *it;
+
+		WriteString(aStream, pNode->msId);
+		WriteString(aStream, pNode->msName);
+		WriteString(aStream, pNode->msType);
+		WriteString(aStream, pNode->msSource);
+		aStream.writeByte(pNode->mbSourceIsFile ? 1 : 0);
+		WriteMatrix(aStream, pNode->m_mtxTransform);
+		WriteMatrix(aStream, pNode->m_mtxWorldTransform);
+		WriteVector3f(aStream, pNode->mvScale);
+		aStream.writeUint32LE(pNode->mlCount);
+
+		aStream.writeUint32LE(pNode->mlstTransforms.size());
+		for (tColladaTransformListIt transIt = pNode->mlstTransforms.begin(); transIt != pNode->mlstTransforms.end(); ++transIt) {
+			WriteString(aStream, transIt->msSid);
+			WriteString(aStream, transIt->msType);
+			WriteFloatVec(aStream, transIt->mvValues);
+		}
+
+		SaveCacheNodes(aStream, pNode);
+	}
+}
+
+static void LoadCacheNodes(cColladaCacheReader &aReader, cColladaNode *apParentNode, cColladaScene *apColladaScene, int alDepth) {
+	// Guard against runaway recursion on a damaged file
+	if (alDepth > 256) {
+		aReader.Fail();
+		return;
+	}
+
+	uint32 lNodeCount = aReader.ReadCount(16);
+	for (uint32 i = 0; i < lNodeCount && !aReader.Failed(); ++i) {
+		cColladaNode *pNode = apParentNode->CreateChild();
+		apColladaScene->mlstNodes.push_back(pNode);
+
+		pNode->msId = aReader.ReadString();
+		pNode->msName = aReader.ReadString();
+		pNode->msType = aReader.ReadString();
+		pNode->msSource = aReader.ReadString();
+		pNode->mbSourceIsFile = aReader.ReadBool();
+		pNode->m_mtxTransform = aReader.ReadMatrix();
+		pNode->m_mtxWorldTransform = aReader.ReadMatrix();
+		pNode->mvScale = aReader.ReadVector3f();
+		pNode->mlCount = aReader.ReadInt();
+
+		uint32 lTransformCount = aReader.ReadCount(12);
+		for (uint32 j = 0; j < lTransformCount; ++j) {
+			pNode->mlstTransforms.push_back(cColladaTransform());
+			cColladaTransform &transform = pNode->mlstTransforms.back();
+			transform.msSid = aReader.ReadString();
+			transform.msType = aReader.ReadString();
+			aReader.ReadFloatVec(transform.mvValues);
+		}
+
+		LoadCacheNodes(aReader, pNode, apColladaScene, alDepth + 1);
+	}
+}
+
+//-----------------------------------------------------------------------
+
+bool cMeshLoaderCollada::SaveBinaryCache(const Common::Path &acCacheFile, uint32 alSourceSize, uint32 alSourceHash,
+										 tColladaImageVec *apColladaImageVec,
+										 tColladaTextureVec *apColladaTextureVec,
+										 tColladaMaterialVec *apColladaMaterialVec,
+										 tColladaLightVec *apColladaLightVec,
+										 tColladaGeometryVec *apColladaGeometryVec,
+										 tColladaControllerVec *apColladaControllerVec,
+										 tColladaAnimationVec *apColladaAnimVec,
+										 cColladaScene *apColladaScene) {
+	Common::MemoryWriteStreamDynamic stream(DisposeAfterUse::YES);
+
+	stream.writeUint32BE(kColladaCacheTag);
+	stream.writeUint32LE(kColladaCacheVersion);
+	stream.writeUint32LE(GetCacheStructureMask(apColladaImageVec, apColladaTextureVec, apColladaMaterialVec,
+											   apColladaLightVec, apColladaGeometryVec, apColladaControllerVec,
+											   apColladaAnimVec, apColladaScene));
+	stream.writeUint32LE(alSourceSize);
+	stream.writeUint32LE(alSourceHash);
+	stream.writeByte(mbZToY ? 1 : 0);
+
+	/////////////////////////////////////////////////
+	// Images, textures and materials
+	if (apColladaImageVec) {
+		stream.writeUint32LE(apColladaImageVec->size());
+		for (size_t i = 0; i < apColladaImageVec->size(); ++i) {
+			cColladaImage &image = (*apColladaImageVec)[i];
+			WriteString(stream, image.msId);
+			WriteString(stream, image.msName);
+			WriteString(stream, image.msSource);
+		}
+	}
+	if (apColladaTextureVec) {
+		stream.writeUint32LE(apColladaTextureVec->size());
+		for (size_t i = 0; i < apColladaTextureVec->size(); ++i) {
+			cColladaTexture &texture = (*apColladaTextureVec)[i];
+			WriteString(stream, texture.msId);
+			WriteString(stream, texture.msName);
+			WriteString(stream, texture.msImage);
+		}
+	}
+	if (apColladaMaterialVec) {
+		stream.writeUint32LE(apColladaMaterialVec->size());
+		for (size_t i = 0; i < apColladaMaterialVec->size(); ++i) {
+			cColladaMaterial &material = (*apColladaMaterialVec)[i];
+			WriteString(stream, material.msId);
+			WriteString(stream, material.msName);
+			WriteString(stream, material.msTexture);
+			WriteColor(stream, material.mDiffuseColor);
+		}
+	}
+
+	/////////////////////////////////////////////////
+	// Lights
+	if (apColladaLightVec) {
+		stream.writeUint32LE(apColladaLightVec->size());
+		for (size_t i = 0; i < apColladaLightVec->size(); ++i) {
+			cColladaLight &light = (*apColladaLightVec)[i];
+			WriteString(stream, light.msId);
+			WriteString(stream, light.msName);
+			WriteString(stream, light.msType);
+			WriteColor(stream, light.mDiffuseColor);
+			stream.writeFloatLE(light.mfAngle);
+		}
+	}
+
+	/////////////////////////////////////////////////
+	// Geometries
+	if (apColladaGeometryVec) {
+		stream.writeUint32LE(apColladaGeometryVec->size());
+		for (size_t i = 0; i < apColladaGeometryVec->size(); ++i) {
+			cColladaGeometry &geometry = (*apColladaGeometryVec)[i];
+			WriteString(stream, geometry.msId);
+			WriteString(stream, geometry.msName);
+			WriteString(stream, geometry.msMaterial);
+
+			stream.writeUint32LE(geometry.mlPosIdxNum);
+			stream.writeUint32LE(geometry.mlNormIdxNum);
+			stream.writeUint32LE(geometry.mlTexIdxNum);
+			stream.writeUint32LE(geometry.mlPosArrayIdx);
+			stream.writeUint32LE(geometry.mlNormArrayIdx);
+			stream.writeUint32LE(geometry.mlTexArrayIdx);
+
+			stream.writeUint32LE(geometry.mvVertexVec.size());
+			for (size_t j = 0; j < geometry.mvVertexVec.size(); ++j) {
+				cVertex &vtx = geometry.mvVertexVec[j];
+				WriteVector3f(stream, vtx.pos);
+				WriteVector3f(stream, vtx.tex);
+				WriteVector3f(stream, vtx.tan);
+				WriteVector3f(stream, vtx.norm);
+				WriteColor(stream, vtx.col);
+			}
+
+			stream.writeUint32LE(geometry.mvIndexVec.size());
+			for (size_t j = 0; j < geometry.mvIndexVec.size(); ++j)
+				stream.writeUint32LE(geometry.mvIndexVec[j]);
+
+			stream.writeUint32LE(geometry.mvExtraVtxVec.size());
+			for (size_t j = 0; j < geometry.mvExtraVtxVec.size(); ++j) {
+				tColladaExtraVtxList &lstExtra = geometry.mvExtraVtxVec[j];
+				stream.writeUint32LE(lstExtra.size());
+				for (tColladaExtraVtxListIt it = lstExtra.begin(); it != lstExtra.end(); ++it) {
+					stream.writeUint32LE(it->mlVtx);
+					stream.writeUint32LE(it->mlNorm);
+					stream.writeUint32LE(it->mlTex);
+					stream.writeUint32LE(it->mlNewVtx);
+				}
+			}
+
+			WriteFloatVec(stream, geometry.mvTangents);
+		}
+	}
+
+	/////////////////////////////////////////////////
+	// Controllers
+	if (apColladaControllerVec) {
+		stream.writeUint32LE(apColladaControllerVec->size());
+		for (size_t i = 0; i < apColladaControllerVec->size(); ++i) {
+			cColladaController &controller = (*apColladaControllerVec)[i];
+			WriteString(stream, controller.msTarget);
+			WriteString(stream, controller.msId);
+			WriteMatrix(stream, controller.m_mtxBindShapeMatrix);
+			stream.writeUint32LE(controller.mlJointPairIdx);
+			stream.writeUint32LE(controller.mlWeightPairIdx);
+
+			stream.writeUint32LE(controller.mvJoints.size());
+			for (size_t j = 0; j < controller.mvJoints.size(); ++j)
+				WriteString(stream, controller.mvJoints[j]);
+
+			WriteFloatVec(stream, controller.mvWeights);
+
+			stream.writeUint32LE(controller.mvMatrices.size());
+			for (size_t j = 0; j < controller.mvMatrices.size(); ++j)
+				WriteMatrix(stream, controller.mvMatrices[j]);
+
+			stream.writeUint32LE(controller.mvPairs.size());
+			for (size_t j = 0; j < controller.mvPairs.size(); ++j) {
+				tColladaJointPairList &lstPairs = controller.mvPairs[j];
+				stream.writeUint32LE(lstPairs.size());
+				for (tColladaJointPairListIt it = lstPairs.begin(); it != lstPairs.end(); ++it) {
+					stream.writeUint32LE(it->mlJoint);
+					stream.writeUint32LE(it->mlWeight);
+				}
+			}
+		}
+	}
+
+	/////////////////////////////////////////////////
+	// Animations
+	if (apColladaAnimVec) {
+		stream.writeUint32LE(apColladaAnimVec->size());
+		for (size_t i = 0; i < apColladaAnimVec->size(); ++i) {
+			cColladaAnimation &anim = (*apColladaAnimVec)[i];
+			WriteString(stream, anim.msId);
+			WriteString(stream, anim.msTargetNode);
+
+			stream.writeUint32LE(anim.mvChannels.size());
+			for (size_t j = 0; j < anim.mvChannels.size(); ++j) {
+				WriteString(stream, anim.mvChannels[j].msId);
+				WriteString(stream, anim.mvChannels[j].msTarget);
+				WriteString(stream, anim.mvChannels[j].msSource);
+			}
+
+			stream.writeUint32LE(anim.mvSamplers.size());
+			for (size_t j = 0; j < anim.mvSamplers.size(); ++j) {
+				WriteString(stream, anim.mvSamplers[j].msId);
+				WriteString(stream, anim.mvSamplers[j].msTimeArray);
+				WriteString(stream, anim.mvSamplers[j].msValueArray);
+				WriteString(stream, anim.mvSamplers[j].msTarget);
+			}
+
+			stream.writeUint32LE(anim.mvSources.size());
+			for (size_t j = 0; j < anim.mvSources.size(); ++j) {
+				WriteString(stream, anim.mvSources[j].msId);
+				WriteFloatVec(stream, anim.mvSources[j].mvValues);
+			}
+		}
+	}
+
+	/////////////////////////////////////////////////
+	// Scene
+	if (apColladaScene) {
+		stream.writeFloatLE(apColladaScene->mfStartTime);
+		stream.writeFloatLE(apColladaScene->mfEndTime);
+		stream.writeFloatLE(apColladaScene->mfDeltaTime);
+		SaveCacheNodes(stream, &apColladaScene->mRoot);
+	}
+
+	Common::DumpFile file;
+	if (!file.open(acCacheFile, true)) {
+		Warning("Couldn't create collada cache file '%s'\n", acCacheFile.toString().c_str());
+		return false;
+	}
+	file.write(stream.getData(), stream.size());
+	if (!file.flush() || file.err()) {
+		Warning("Couldn't write collada cache file '%s'\n", acCacheFile.toString().c_str());
+		return false;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------
+
+bool cMeshLoaderCollada::LoadBinaryCache(const Common::Path &acCacheFile, uint32 alSourceSize, uint32 alSourceHash,
+										 tColladaImageVec *apColladaImageVec,
+										 tColladaTextureVec *apColladaTextureVec,
+										 tColladaMaterialVec *apColladaMaterialVec,
+										 tColladaLightVec *apColladaLightVec,
+										 tColladaGeometryVec *apColladaGeometryVec,
+										 tColladaControllerVec *apColladaControllerVec,
+										 tColladaAnimationVec *apColladaAnimVec,
+										 cColladaScene *apColladaScene) {
+	Common::FSNode node(acCacheFile);
+	if (!node.exists())
+		return false;
+
+	Common::File file;
+	if (!file.open(node))
+		return false;
+
+	// Read the whole cache at once, all parsing below is done from memory
+	Common::ScopedPtr<Common::SeekableReadStream> pStream(file.readStream(file.size()));
+	file.close();
+	if (!pStream)
+		return false;
+
+	if (pStream->readUint32BE() != kColladaCacheTag ||
+		pStream->readUint32LE() != kColladaCacheVersion ||
+		pStream->readUint32LE() != GetCacheStructureMask(apColladaImageVec, apColladaTextureVec, apColladaMaterialVec,
+														 apColladaLightVec, apColladaGeometryVec, apColladaControllerVec,
+														 apColladaAnimVec, apColladaScene) ||
+		pStream->readUint32LE() != alSourceSize ||
+		pStream->readUint32LE() != alSourceHash) {
+		return false;
+	}
+
+	cColladaCacheReader reader(*pStream);
+	mbZToY = reader.ReadBool();
+
+	/////////////////////////////////////////////////
+	// Images, textures and materials
+	if (apColladaImageVec) {
+		apColladaImageVec->resize(reader.ReadCount(12));
+		for (size_t i = 0; i < apColladaImageVec->size(); ++i) {
+			cColladaImage &image = (*apColladaImageVec)[i];
+			image.msId = reader.ReadString();
+			image.msName = reader.ReadString();
+			image.msSource = reader.ReadString();
+		}
+	}
+	if (apColladaTextureVec) {
+		apColladaTextureVec->resize(reader.ReadCount(12));
+		for (size_t i = 0; i < apColladaTextureVec->size(); ++i) {
+			cColladaTexture &texture = (*apColladaTextureVec)[i];
+			texture.msId = reader.ReadString();
+			texture.msName = reader.ReadString();
+			texture.msImage = reader.ReadString();
+		}
+	}
+	if (apColladaMaterialVec) {
+		apColladaMaterialVec->resize(reader.ReadCount(28));
+		for (size_t i = 0; i < apColladaMaterialVec->size(); ++i) {
+			cColladaMaterial &material = (*apColladaMaterialVec)[i];
+			material.msId = reader.ReadString();
+			material.msName = reader.ReadString();
+			material.msTexture = reader.ReadString();
+			material.mDiffuseColor = reader.ReadColor();
+		}
+	}
+
+	/////////////////////////////////////////////////
+	// Lights
+	if (apColladaLightVec) {
+		apColladaLightVec->resize(reader.ReadCount(32));
+		for (size_t i = 0; i < apColladaLightVec->size(); ++i) {
+			cColladaLight &light = (*apColladaLightVec)[i];
+			light.msId = reader.ReadString();
+			light.msName = reader.ReadString();
+			light.msType = reader.ReadString();
+			light.mDiffuseColor = reader.ReadColor();
+			light.mfAngle = reader.ReadFloat();
+		}
+	}
+
+	/////////////////////////////////////////////////
+	// Geometries
+	if (apColladaGeometryVec) {
+		apColladaGeometryVec->resize(reader.ReadCount(52));
+		for (size_t i = 0; i < apColladaGeometryVec->size() && !reader.Failed(); ++i) {
+			cColladaGeometry &geometry = (*apColladaGeometryVec)[i];
+			geometry.msId = reader.ReadString();
+			geometry.msName = reader.ReadString();
+			geometry.msMaterial = reader.ReadString();
+
+			geometry.mlPosIdxNum = reader.ReadInt();
+			geometry.mlNormIdxNum = reader.ReadInt();
+			geometry.mlTexIdxNum = reader.ReadInt();
+			geometry.mlPosArrayIdx = reader.ReadInt();
+			geometry.mlNormArrayIdx = reader.ReadInt();
+			geometry.mlTexArrayIdx = reader.ReadInt();
+
+			geometry.mvVertexVec.resize(reader.ReadCount(64));
+			for (size_t j = 0; j < geometry.mvVertexVec.size(); ++j) {
+				cVertex &vtx = geometry.mvVertexVec[j];
+				vtx.pos = reader.ReadVector3f();
+				vtx.tex = reader.ReadVector3f();
+				vtx.tan = reader.ReadVector3f();
+				vtx.norm = reader.ReadVector3f();
+				vtx.col = reader.ReadColor();
+			}
+
+			geometry.mvIndexVec.resize(reader.ReadCount(4));
+			for (size_t j = 0; j < geometry.mvIndexVec.size(); ++j)
+				geometry.mvIndexVec[j] = (unsigned int)reader.ReadInt();
+
+			geometry.mvExtraVtxVec.resize(reader.ReadCount(4));
+			for (size_t j = 0; j < geometry.mvExtraVtxVec.size(); ++j) {
+				tColladaExtraVtxList &lstExtra = geometry.mvExtraVtxVec[j];
+				uint32 lExtraCount = reader.ReadCount(16);
+				for (uint32 k = 0; k < lExtraCount; ++k) {
+					int lVtx = reader.ReadInt();
+					int lNorm = reader.ReadInt();
+					int lTex = reader.ReadInt();
+					int lNewVtx = reader.ReadInt();
+					lstExtra.push_back(cColladaExtraVtx(lVtx, lNorm, lTex, lNewVtx));
+				}
+			}
+
+			reader.ReadFloatVec(geometry.mvTangents);
+		}
+	}
+
+	/////////////////////////////////////////////////
+	// Controllers
+	if (apColladaControllerVec) {
+		apColladaControllerVec->resize(reader.ReadCount(96));
+		for (size_t i = 0; i < apColladaControllerVec->size() && !reader.Failed(); ++i) {
+			cColladaController &controller = (*apColladaControllerVec)[i];
+			controller.msTarget = reader.ReadString();
+			controller.msId = reader.ReadString();
+			controller.m_mtxBindShapeMatrix = reader.ReadMatrix();
+			controller.mlJointPairIdx = reader.ReadInt();
+			controller.mlWeightPairIdx = reader.ReadInt();
+
+			controller.mvJoints.resize(reader.ReadCount(4));
+			for (size_t j = 0; j < controller.mvJoints.size(); ++j)
+				controller.mvJoints[j] = reader.ReadString();
+
+			reader.ReadFloatVec(controller.mvWeights);
+
+			controller.mvMatrices.resize(reader.ReadCount(64));
+			for (size_t j = 0; j < controller.mvMatrices.size(); ++j)
+				controller.mvMatrices[j] = reader.ReadMatrix();
+
+			controller.mvPairs.resize(reader.ReadCount(4));
+			for (size_t j = 0; j < controller.mvPairs.size(); ++j) {
+				uint32 lPairCount = reader.ReadCount(8);
+				for (uint32 k = 0; k < lPairCount; ++k) {
+					int lJoint = reader.ReadInt();
+					int lWeight = reader.ReadInt();
+					controller.mvPairs[j].push_back(cColladaJointPair(lJoint, lWeight));
+				}
+			}
+		}
+	}
+
+	/////////////////////////////////////////////////
+	// Animations
+	if (apColladaAnimVec) {
+		apColladaAnimVec->resize(reader.ReadCount(20));
+		for (size_t i = 0; i < apColladaAnimVec->size() && !reader.Failed(); ++i) {
+			cColladaAnimation &anim = (*apColladaAnimVec)[i];
+			anim.msId = reader.ReadString();
+			anim.msTargetNode = reader.ReadString();
+
+			anim.mvChannels.resize(reader.ReadCount(12));
+			for (size_t j = 0; j < anim.mvChannels.size(); ++j) {
+				anim.mvChannels[j].msId = reader.ReadString();
+				anim.mvChannels[j].msTarget = reader.ReadString();
+				anim.mvChannels[j].msSource = reader.ReadString();
+			}
+
+			anim.mvSamplers.resize(reader.ReadCount(16));
+			for (size_t j = 0; j < anim.mvSamplers.size(); ++j) {
+				anim.mvSamplers[j].msId = reader.ReadString();
+				anim.mvSamplers[j].msTimeArray = reader.ReadString();
+				anim.mvSamplers[j].msValueArray = reader.ReadString();
+				anim.mvSamplers[j].msTarget = reader.ReadString();
+			}
+
+			anim.mvSources.resize(reader.ReadCount(8));
+			for (size_t j = 0; j < anim.mvSources.size(); ++j) {
+				anim.mvSources[j].msId = reader.ReadString();
+				reader.ReadFloatVec(anim.mvSources[j].mvValues);
+			}
+		}
+	}
+
+	/////////////////////////////////////////////////
+	// Scene
+	if (apColladaScene) {
+		apColladaScene->ResetNodes();
+		apColladaScene->mfStartTime = reader.ReadFloat();
+		apColladaScene->mfEndTime = reader.ReadFloat();
+		apColladaScene->mfDeltaTime = reader.ReadFloat();
+		LoadCacheNodes(reader, &apColladaScene->mRoot, apColladaScene, 0);
+	}
+
+	if (reader.Failed()) {
+		Warning("Collada cache file '%s' is damaged, ignoring it\n", acCacheFile.toString().c_str());
+
+		// Leave the structures as empty as the XML loader expects them
+		if (apColladaImageVec)
+			apColladaImageVec->clear();
+		if (apColladaTextureVec)
+			apColladaTextureVec->clear();
+		if (apColladaMaterialVec)
+			apColladaMaterialVec->clear();
+		if (apColladaLightVec)
+			apColladaLightVec->clear();
+		if (apColladaGeometryVec)
+			apColladaGeometryVec->clear();
+		if (apColladaControllerVec)
+			apColladaControllerVec->clear();
+		if (apColladaAnimVec)
+			apColladaAnimVec->clear();
+		if (apColladaScene)
+			apColladaScene->ResetNodes();
+		return false;
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------
+
+} // namespace hpl
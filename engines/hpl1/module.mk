@@ -97,6 +97,7 @@ MODULE_OBJS := \
 	engine/impl/LowLevelPhysicsNewton.o \
 	engine/impl/LowLevelSoundOpenAL.o \
 	engine/impl/MeshLoaderCollada.o \
+	engine/impl/MeshLoaderColladaCache.o \
 	engine/impl/MeshLoaderColladaHelpers.o \
 	engine/impl/MeshLoaderColladaLoader.o \
 	engine/impl/MeshLoaderMSH.o \
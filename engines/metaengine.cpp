@@ -26,6 +26,7 @@
 #include "backends/keymapper/keymap.h"
 #include "backends/keymapper/standard-actions.h"
 
+#include "common/memstream.h"
 #include "common/savefile.h"
 #include "common/system.h"
 #include "common/translation.h"
@@ -406,6 +407,9 @@ SaveStateList MetaEngine::listSaves(const char *target) const {
 		}
 	}
 
+	// Persist the metadata read while listing for the next time
+	saveFileMan->flushCachedMetaInfo();
+
 	// Sort saves based on slot number.
 	Common::sort(saveList.begin(), saveList.end(), SaveStateDescriptorSlotComparator());
 	return saveList;
@@ -466,19 +470,98 @@ bool MetaEngine::removeSaveState(const char *target, int slot) const {
 	return g_system->getSavefileManager()->removeSavefile(getSavegameFile(slot, target));
 }
 
+#define CACHED_HEADER_VERSION 1
+
+/**
+ * Serialize the parts of an extended savegame header needed to build its
+ * descriptor, so that the save file manager can index them. An invalid
+ * header is stored too, so that foreign saves are not parsed every time.
+ */
+static void writeCachedSavegameHeader(Common::Array<byte> &data, const ExtendedSavegameHeader *header, bool valid) {
+	Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+	out.writeByte(CACHED_HEADER_VERSION);
+	out.writeByte(valid);
+	if (valid) {
+		out.writeUint32LE(header->date);
+		out.writeUint16LE(header->time);
+		out.writeUint32LE(header->playtime);
+		out.writeUint32LE(header->description.size());
+		out.writeString(header->description);
+		out.writeByte(header->isAutosave);
+		out.writeByte(header->thumbnail != nullptr);
+		if (header->thumbnail)
+			Graphics::saveThumbnail(out, *header->thumbnail);
+	}
+
+	data.resize(out.size());
+	memcpy(data.data(), out.getData(), out.size());
+}
+
+static bool readCachedSavegameHeader(const Common::Array<byte> &data, ExtendedSavegameHeader *header, bool &valid) {
+	Common::MemoryReadStream in(data.data(), data.size());
+	if (in.readByte() != CACHED_HEADER_VERSION)
+		return false;
+
+	valid = in.readByte() != 0;
+	if (!valid)
+		return !in.err();
+
+	header->date = in.readUint32LE();
+	header->time = in.readUint16LE();
+	header->playtime = in.readUint32LE();
+	const uint32 descriptionSize = in.readUint32LE();
+	if (descriptionSize > in.size() - in.pos())
+		return false;
+	header->description = in.readString(0, descriptionSize);
+	header->isAutosave = in.readByte() != 0;
+	if (in.readByte() && !Graphics::loadThumbnail(in, header->thumbnail))
+		return false;
+
+	return !in.err();
+}
+
 SaveStateDescriptor MetaEngine::querySaveMetaInfos(const char *target, int slot) const {
 	if (!hasFeature(kSavesUseExtendedFormat))
 		return SaveStateDescriptor();
 
-	Common::ScopedPtr<Common::InSaveFile> f(g_system->getSavefileManager()->openForLoading(
-		getSavegameFile(slot, target)));
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	const Common::String filename = getSavegameFile(slot, target);
+	const Common::String index = target ? Common::String(target) : ConfMan.getActiveDomainName();
+
+	Common::Array<byte> cached;
+	if (!index.empty() && saveFileMan->getCachedMetaInfo(index, filename, cached)) {
+		ExtendedSavegameHeader header;
+		bool valid;
+		if (readCachedSavegameHeader(cached, &header, valid)) {
+			if (!valid)
+				return SaveStateDescriptor();
+
+			SaveStateDescriptor desc(this, slot, Common::U32String());
+			parseSavegameHeader(&header, &desc);
+			desc.setThumbnail(header.thumbnail);
+			desc.setAutosave(header.isAutosave);
+			return desc;
+		}
+		delete header.thumbnail;
+	}
+
+	Common::ScopedPtr<Common::InSaveFile> f(saveFileMan->openForLoading(filename));
 
 	if (f) {
 		ExtendedSavegameHeader header;
 		if (!readSavegameHeader(f.get(), &header, false)) {
+			if (!index.empty()) {
+				writeCachedSavegameHeader(cached, &header, false);
+				saveFileMan->setCachedMetaInfo(index, filename, cached);
+			}
 			return SaveStateDescriptor();
 		}
 
+		if (!index.empty()) {
+			writeCachedSavegameHeader(cached, &header, true);
+			saveFileMan->setCachedMetaInfo(index, filename, cached);
+		}
+
 		// Create the return descriptor
 		SaveStateDescriptor desc(this, slot, Common::U32String());
 		parseSavegameHeader(&header, &desc);
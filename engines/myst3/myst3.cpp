@@ -40,6 +40,7 @@
 #include "engines/myst3/myst3.h"
 #include "engines/myst3/nodecube.h"
 #include "engines/myst3/nodeframe.h"
+#include "engines/myst3/prefetch.h"
 #include "engines/myst3/scene.h"
 #include "engines/myst3/state.h"
 #include "engines/myst3/cursor.h"
@@ -66,7 +67,7 @@ Myst3Engine::Myst3Engine(OSystem *syst, const Myst3GameDescription *version) :
 		_db(nullptr), _scriptEngine(nullptr),
 		_state(nullptr), _node(nullptr), _scene(nullptr), _archiveNode(nullptr),
 		_cursor(nullptr), _inventory(nullptr), _gfx(nullptr), _menu(nullptr),
-		_rnd(nullptr), _sound(nullptr), _ambient(nullptr),
+		_rnd(nullptr), _sound(nullptr), _ambient(nullptr), _prefetcher(nullptr),
 		_inputSpacePressed(false), _inputEnterPressed(false),
 		_inputEscapePressed(false), _inputTildePressed(false),
 		_inputEscapePressedNotConsumed(false),
@@ -108,6 +109,7 @@ Myst3Engine::Myst3Engine(OSystem *syst, const Myst3GameDescription *version) :
 Myst3Engine::~Myst3Engine() {
 	closeArchives();
 
+	delete _prefetcher;
 	delete _menu;
 	delete _inventory;
 	delete _cursor;
@@ -177,6 +179,7 @@ Common::Error Myst3Engine::run() {
 		_menu = new PagingMenu(this);
 	}
 	_archiveNode = new Archive();
+	_prefetcher = new NodePrefetcher(this);
 
 	_system->showMouse(false);
 
@@ -220,6 +223,9 @@ Common::Error Myst3Engine::run() {
 		}
 
 		drawFrame();
+
+		// Use the time left before the next frame to prepare the next nodes
+		_prefetcher->decodeNext();
 	}
 
 	unloadNode();
@@ -903,6 +909,7 @@ void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
 
 		Common::String nodeFile = Common::String::format("%snodes.m3a", newRoomName.c_str());
 
+		_prefetcher->clear();
 		_archiveNode->close();
 		if (!_archiveNode->open(nodeFile.c_str(), newRoomName.c_str())) {
 			error("Unable to open archive %s", nodeFile.c_str());
@@ -919,6 +926,8 @@ void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
 	_shakeEffect = ShakeEffect::create(this);
 	_rotationEffect = RotationEffect::create(this);
 
+	_prefetcher->queueReachableNodes();
+
 	// WORKAROUND: In Narayan, the scripts in node NACH 9 test on var 39
 	// without first reinitializing it leading to Saavedro not always giving
 	// Releeshan to the player when he is trapped between both shields.
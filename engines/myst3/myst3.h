@@ -73,6 +73,7 @@ class SunSpot;
 class Renderer;
 class Menu;
 class Node;
+class NodePrefetcher;
 class Sound;
 class Ambient;
 class ScriptedMovie;
@@ -102,6 +103,7 @@ public:
 	Database *_db;
 	Sound *_sound;
 	Ambient *_ambient;
+	NodePrefetcher *_prefetcher;
 
 	Common::RandomSource *_rnd;
 
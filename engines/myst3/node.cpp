@@ -23,6 +23,7 @@
 #include "engines/myst3/effects.h"
 #include "engines/myst3/node.h"
 #include "engines/myst3/myst3.h"
+#include "engines/myst3/prefetch.h"
 #include "engines/myst3/state.h"
 #include "engines/myst3/subtitles.h"
 
@@ -33,7 +34,11 @@
 namespace Myst3 {
 
 void Face::setTextureFromJPEG(const ResourceDescription *jpegDesc) {
-	_bitmap = Myst3Engine::decodeJpeg(jpegDesc);
+	if (_vm->_prefetcher)
+		_bitmap = _vm->_prefetcher->takeFace(*jpegDesc);
+
+	if (!_bitmap)
+		_bitmap = Myst3Engine::decodeJpeg(jpegDesc);
 	if (_is3D) {
 		_texture = _vm->_gfx->createTexture3D(_bitmap);
 	} else {
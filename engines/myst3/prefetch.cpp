@@ -0,0 +1,190 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "engines/myst3/prefetch.h"
+#include "engines/myst3/database.h"
+#include "engines/myst3/myst3.h"
+#include "engines/myst3/state.h"
+
+#include "common/debug.h"
+
+#include "graphics/surface.h"
+
+namespace Myst3 {
+
+NodePrefetcher::NodePrefetcher(Myst3Engine *vm) :
+		_vm(vm),
+		_cacheSize(0) {
+}
+
+NodePrefetcher::~NodePrefetcher() {
+	clear();
+}
+
+void NodePrefetcher::clear() {
+	_queue.clear();
+
+	for (Common::List<Entry>::iterator it = _cache.begin(); it != _cache.end(); it++) {
+		freeEntry(*it);
+	}
+	_cache.clear();
+	_cacheSize = 0;
+}
+
+void NodePrefetcher::freeEntry(Entry &entry) {
+	_cacheSize -= entry.surface->pitch * entry.surface->h;
+	entry.surface->free();
+	delete entry.surface;
+	entry.surface = nullptr;
+}
+
+void NodePrefetcher::queueNode(uint16 nodeID, Common::List<ResourceDescription> &wanted) {
+	if (nodeID == 0 || nodeID == _vm->_state->getLocationNode()) {
+		return;
+	}
+
+	// Same lookups as NodeCube and NodeFrame
+	ResourceDescription jpegDesc = _vm->getFileDescription("", nodeID, 1, Archive::kCubeFace);
+	if (jpegDesc.isValid()) {
+		for (uint i = 0; i < 6; i++) {
+			jpegDesc = _vm->getFileDescription("", nodeID, i + 1, Archive::kCubeFace);
+			if (jpegDesc.isValid()) {
+				wanted.push_back(jpegDesc);
+			}
+		}
+		return;
+	}
+
+	jpegDesc = _vm->getFileDescription("", nodeID, 1, Archive::kLocalizedFrame);
+
+	if (!jpegDesc.isValid())
+		jpegDesc = _vm->getFileDescription("", nodeID, 0, Archive::kFrame);
+
+	if (!jpegDesc.isValid())
+		jpegDesc = _vm->getFileDescription("", nodeID, 1, Archive::kFrame);
+
+	if (jpegDesc.isValid())
+		wanted.push_back(jpegDesc);
+}
+
+void NodePrefetcher::queueReachableNodes() {
+	NodePtr nodeData = _vm->_db->getNodeData(
+			_vm->_state->getLocationNode(),
+			_vm->_state->getLocationRoom(),
+			_vm->_state->getLocationAge());
+
+	Common::List<ResourceDescription> wanted;
+
+	if (nodeData) {
+		// Look for node changes in the hotspot scripts. Only nodes from the
+		// current room are prefetched, their archive is already open.
+		for (uint i = 0; i < nodeData->hotspots.size(); i++) {
+			const Common::Array<Opcode> &script = nodeData->hotspots[i].script;
+
+			for (uint j = 0; j < script.size(); j++) {
+				const Opcode &opcode = script[j];
+
+				switch (opcode.op) {
+				case 136: // goToNodeTransition
+				case 137: // goToNodeTrans2
+				case 138: // goToNodeTrans1
+				case 164: // changeNode
+					if (!opcode.args.empty())
+						queueNode(_vm->_state->valueOrVarValue(opcode.args[0]), wanted);
+					break;
+				case 139: // goToRoomNode
+				case 165: // changeNodeRoom
+					if (opcode.args.size() >= 2 && _vm->_state->valueOrVarValue(opcode.args[0]) == (int32)_vm->_state->getLocationRoom())
+						queueNode(_vm->_state->valueOrVarValue(opcode.args[1]), wanted);
+					break;
+				default:
+					break;
+				}
+			}
+		}
+	}
+
+	// Keep the faces that are still wanted, drop the others
+	Common::List<Entry>::iterator it = _cache.begin();
+	while (it != _cache.end()) {
+		bool isWanted = false;
+		for (Common::List<ResourceDescription>::iterator w = wanted.begin(); w != wanted.end(); w++) {
+			if (*w == it->desc) {
+				wanted.erase(w);
+				isWanted = true;
+				break;
+			}
+		}
+
+		if (isWanted) {
+			it++;
+		} else {
+			freeEntry(*it);
+			it = _cache.erase(it);
+		}
+	}
+
+	// Several hotspots may lead to the same node
+	_queue.clear();
+	for (Common::List<ResourceDescription>::iterator w = wanted.begin(); w != wanted.end(); w++) {
+		bool isQueued = false;
+		for (Common::List<ResourceDescription>::iterator q = _queue.begin(); q != _queue.end(); q++) {
+			if (*q == *w) {
+				isQueued = true;
+				break;
+			}
+		}
+
+		if (!isQueued)
+			_queue.push_back(*w);
+	}
+
+	debugC(kDebugNode, "Prefetch: %d faces queued, %d cached", (int)_queue.size(), (int)_cache.size());
+}
+
+void NodePrefetcher::decodeNext() {
+	if (_queue.empty() || _cacheSize >= kMemoryBudget) {
+		return;
+	}
+
+	Entry entry;
+	entry.desc = _queue.front();
+	_queue.pop_front();
+
+	entry.surface = Myst3Engine::decodeJpeg(&entry.desc);
+	_cacheSize += entry.surface->pitch * entry.surface->h;
+	_cache.push_back(entry);
+}
+
+Graphics::Surface *NodePrefetcher::takeFace(const ResourceDescription &jpegDesc) {
+	for (Common::List<Entry>::iterator it = _cache.begin(); it != _cache.end(); it++) {
+		if (it->desc == jpegDesc) {
+			Graphics::Surface *surface = it->surface;
+			_cacheSize -= surface->pitch * surface->h;
+			_cache.erase(it);
+			return surface;
+		}
+	}
+
+	return nullptr;
+}
+
+} // End of namespace Myst3
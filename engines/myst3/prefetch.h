@@ -0,0 +1,85 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef MYST3_PREFETCH_H
+#define MYST3_PREFETCH_H
+
+#include "common/list.h"
+
+#include "engines/myst3/archive.h"
+
+namespace Graphics {
+struct Surface;
+}
+
+namespace Myst3 {
+
+class Myst3Engine;
+
+/**
+ * Decodes ahead of time the backgrounds of the nodes the player can
+ * reach from the current node, so entering them does not stall on
+ * JPEG decoding.
+ *
+ * The work is spread over the main loop, one face per frame, and the
+ * decoded faces are kept within a memory budget.
+ */
+class NodePrefetcher {
+public:
+	NodePrefetcher(Myst3Engine *vm);
+	~NodePrefetcher();
+
+	/** Replace the prefetch queue with the nodes reachable from the current node */
+	void queueReachableNodes();
+
+	/** Decode the next queued face, if the memory budget allows it */
+	void decodeNext();
+
+	/**
+	 * Get the decoded bitmap for a face, if it was prefetched.
+	 * The caller takes ownership of the surface.
+	 */
+	Graphics::Surface *takeFace(const ResourceDescription &jpegDesc);
+
+	/** Drop everything, must be called before an archive is closed */
+	void clear();
+
+private:
+	static const uint32 kMemoryBudget = 40 * 1024 * 1024;
+
+	struct Entry {
+		ResourceDescription desc;
+		Graphics::Surface *surface;
+	};
+
+	void queueNode(uint16 nodeID, Common::List<ResourceDescription> &wanted);
+	void freeEntry(Entry &entry);
+
+	Myst3Engine *_vm;
+
+	Common::List<ResourceDescription> _queue;
+	Common::List<Entry> _cache;
+	uint32 _cacheSize;
+};
+
+} // End of namespace Myst3
+
+#endif
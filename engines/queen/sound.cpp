@@ -98,7 +98,7 @@ class SilentSound : public PCSound {
 public:
 	SilentSound(Audio::Mixer *mixer, QueenEngine *vm) : PCSound(mixer, vm) {}
 protected:
-	void playSoundData(Common::File *f, uint32 size, Audio::SoundHandle *soundHandle) override {
+	void playSoundData(Common::File *f, uint32 size, const char *name, Audio::SoundHandle *soundHandle) override {
 		// Do nothing
 	}
 };
@@ -107,7 +107,7 @@ class SBSound : public PCSound {
 public:
 	SBSound(Audio::Mixer *mixer, QueenEngine *vm) : PCSound(mixer, vm) {}
 protected:
-	void playSoundData(Common::File *f, uint32 size, Audio::SoundHandle *soundHandle) override;
+	void playSoundData(Common::File *f, uint32 size, const char *name, Audio::SoundHandle *soundHandle) override;
 };
 
 #ifdef USE_MAD
@@ -115,10 +115,8 @@ class MP3Sound : public PCSound {
 public:
 	MP3Sound(Audio::Mixer *mixer, QueenEngine *vm) : PCSound(mixer, vm) {}
 protected:
-	void playSoundData(Common::File *f, uint32 size, Audio::SoundHandle *soundHandle) override {
-		Common::SeekableReadStream *tmp = f->readStream(size);
-		assert(tmp);
-		_mixer->playStream(Audio::Mixer::kSFXSoundType, soundHandle, new AudioStreamWrapper(Audio::makeMP3Stream(tmp, DisposeAfterUse::YES)));
+	void playSoundData(Common::File *f, uint32 size, const char *name, Audio::SoundHandle *soundHandle) override {
+		_mixer->playStream(Audio::Mixer::kSFXSoundType, soundHandle, new AudioStreamWrapper(makeCompressedStream(f, size, name, soundHandle, Audio::makeMP3Stream)));
 	}
 };
 #endif
@@ -128,10 +126,8 @@ class OGGSound : public PCSound {
 public:
 	OGGSound(Audio::Mixer *mixer, QueenEngine *vm) : PCSound(mixer, vm) {}
 protected:
-	void playSoundData(Common::File *f, uint32 size, Audio::SoundHandle *soundHandle) override {
-		Common::SeekableReadStream *tmp = f->readStream(size);
-		assert(tmp);
-		_mixer->playStream(Audio::Mixer::kSFXSoundType, soundHandle, new AudioStreamWrapper(Audio::makeVorbisStream(tmp, DisposeAfterUse::YES)));
+	void playSoundData(Common::File *f, uint32 size, const char *name, Audio::SoundHandle *soundHandle) override {
+		_mixer->playStream(Audio::Mixer::kSFXSoundType, soundHandle, new AudioStreamWrapper(makeCompressedStream(f, size, name, soundHandle, Audio::makeVorbisStream)));
 	}
 };
 #endif
@@ -141,10 +137,8 @@ class FLACSound : public PCSound {
 public:
 	FLACSound(Audio::Mixer *mixer, QueenEngine *vm) : PCSound(mixer, vm) {}
 protected:
-	void playSoundData(Common::File *f, uint32 size, Audio::SoundHandle *soundHandle) override {
-		Common::SeekableReadStream *tmp = f->readStream(size);
-		assert(tmp);
-		_mixer->playStream(Audio::Mixer::kSFXSoundType, soundHandle, new AudioStreamWrapper(Audio::makeFLACStream(tmp, DisposeAfterUse::YES)));
+	void playSoundData(Common::File *f, uint32 size, const char *name, Audio::SoundHandle *soundHandle) override {
+		_mixer->playStream(Audio::Mixer::kSFXSoundType, soundHandle, new AudioStreamWrapper(makeCompressedStream(f, size, name, soundHandle, Audio::makeFLACStream)));
 	}
 };
 #endif // #ifdef USE_FLAC
@@ -299,14 +293,24 @@ void PCSound::playSound(const char *base, bool isSpeech) {
 	uint32 size;
 	Common::File *f = _vm->resource()->findSound(name, &size);
 	if (f) {
-		playSoundData(f, size, isSpeech ? &_speechHandle : &_sfxHandle);
+		playSoundData(f, size, name, isSpeech ? &_speechHandle : &_sfxHandle);
 		_speechSfxExists = isSpeech;
 	} else {
 		_speechSfxExists = false;
 	}
 }
 
-void SBSound::playSoundData(Common::File *f, uint32 size, Audio::SoundHandle *soundHandle) {
+Audio::SeekableAudioStream *PCSound::makeCompressedStream(Common::File *f, uint32 size, const char *name, Audio::SoundHandle *soundHandle, Audio::SeekableAudioStreamFactory factory) {
+	Common::SeekableReadStream *tmp = f->readStream(size);
+	assert(tmp);
+	// The same few sound effects are played over and over, decode them
+	// only once. Speech is not repeated.
+	if (soundHandle == &_sfxHandle)
+		return Audio::makeCachedStream(name, tmp, DisposeAfterUse::YES, factory);
+	return factory(tmp, DisposeAfterUse::YES);
+}
+
+void SBSound::playSoundData(Common::File *f, uint32 size, const char *name, Audio::SoundHandle *soundHandle) {
 	// In order to simplify the code, we don't parse the .sb header but hard-code the
 	// values. Refer to tracker item #3590 for details on the format/fields.
 	int headerSize;
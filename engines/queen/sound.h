@@ -23,6 +23,7 @@
 #define QUEEN_SOUND_H
 
 #include "audio/mixer.h"
+#include "audio/samplecache.h"
 
 namespace Audio {
 class AudioStream;
@@ -142,7 +143,13 @@ public:
 protected:
 	void playSound(const char *base, bool isSpeech);
 
-	virtual void playSoundData(Common::File *f, uint32 size, Audio::SoundHandle *soundHandle) = 0;
+	virtual void playSoundData(Common::File *f, uint32 size, const char *name, Audio::SoundHandle *soundHandle) = 0;
+
+	/**
+	 * Decode a compressed sound with the given factory, through the sample
+	 * cache for sound effects.
+	 */
+	Audio::SeekableAudioStream *makeCompressedStream(Common::File *f, uint32 size, const char *name, Audio::SoundHandle *soundHandle, Audio::SeekableAudioStreamFactory factory);
 
 	Audio::SoundHandle _sfxHandle;
 	Audio::SoundHandle _speechHandle;
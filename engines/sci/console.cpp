@@ -244,6 +244,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("vm_vars",			WRAP_METHOD(Console, cmdVMVars));
 	registerCmd("vmvars",				WRAP_METHOD(Console, cmdVMVars));					// alias
 	registerCmd("vv",					WRAP_METHOD(Console, cmdVMVars));					// alias
+	registerCmd("vm_caches",			WRAP_METHOD(Console, cmdVMCaches));
 	registerCmd("locals",				WRAP_METHOD(Console, cmdLocalVars));
 	registerCmd("l",					WRAP_METHOD(Console, cmdLocalVars));				// alias
 	registerCmd("stack",				WRAP_METHOD(Console, cmdStack));
@@ -267,6 +268,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	_debugState.breakpointWasHit = false;
 	_debugState._breakpoints.clear(); // No breakpoints defined
 	_debugState._activeBreakpointTypes = 0;
+	_debugState.disableVMCaches = false;
 }
 
 Console::~Console() {
@@ -452,6 +454,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" script_said - Shows all said - strings inside a specified script\n");
 	debugPrintf(" vm_varlist / vmvarlist / vl - Shows the addresses of variables in the VM\n");
 	debugPrintf(" vm_vars / vmvars / vv - Displays or changes variables in the VM\n");
+	debugPrintf(" vm_caches - Enables or disables the VM instruction and selector caches\n");
 	debugPrintf(" locals / l - Displays or changes local variables in the VM\n");
 	debugPrintf(" stack / st - Lists the specified number of stack elements\n");
 	debugPrintf(" value_type - Determines the type of a value\n");
@@ -2934,6 +2937,28 @@ bool Console::cmdGCNormalize(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdVMCaches(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("Enables or disables caching of decoded instructions and selector lookups in the VM\n");
+		debugPrintf("usage: %s [on|off]\n", argv[0]);
+		return true;
+	}
+
+	if (argc == 2) {
+		if (!scumm_stricmp(argv[1], "on")) {
+			_debugState.disableVMCaches = false;
+		} else if (!scumm_stricmp(argv[1], "off")) {
+			_debugState.disableVMCaches = true;
+		} else {
+			debugPrintf("Invalid parameter %s\n", argv[1]);
+			return true;
+		}
+	}
+
+	debugPrintf("VM caches are %s\n", _debugState.disableVMCaches ? "off" : "on");
+	return true;
+}
+
 bool Console::cmdVMVarlist(int argc, const char **argv) {
 	EngineState *s = _engine->_gamestate;
 	const char *varnames[] = {"global", "local", "temp", "param"};
@@ -83,6 +83,7 @@ struct DebugState {
 	StackPtr old_sp;
 	Common::List<Breakpoint> _breakpoints;   //< List of breakpoints
 	int _activeBreakpointTypes;  //< Bit mask specifying which types of breakpoints are active
+	bool disableVMCaches;        //< Decode every instruction and look up every selector from scratch
 
 	void updateActiveBreakpointTypes();
 };
@@ -74,6 +74,8 @@ void Script::freeScript(const bool keepLocalsSegment) {
 	_offsetLookupObjectCount = 0;
 	_offsetLookupStringCount = 0;
 	_offsetLookupSaidCount = 0;
+
+	_decodedInstructions.clear();
 }
 
 enum {
@@ -696,6 +698,17 @@ int Script::relocateOffsetSci3(uint32 offset) const {
 }
 #endif
 
+const PMachineInstruction &Script::decodeInstruction(const uint32 offset) {
+	if (_decodedInstructions.empty()) {
+		_decodedInstructions.resize(kDecodedInstructionCacheSize);
+	}
+
+	PMachineInstruction &instruction = _decodedInstructions[offset & (kDecodedInstructionCacheSize - 1)];
+	instruction.size = readPMachineInstruction(getBuf(offset), instruction.extOpcode, instruction.opparams);
+	instruction.offset = offset;
+	return instruction;
+}
+
 bool Script::relocateLocal(SegmentId segment, int location, uint32 offset) {
 	if (_localsBlock)
 		return relocateBlock(_localsBlock->_locals, _localsOffset, segment, location, offset);
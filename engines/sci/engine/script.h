@@ -68,6 +68,28 @@ struct offsetLookupArrayEntry {
 
 typedef Common::Array<offsetLookupArrayEntry> offsetLookupArrayType;
 
+enum {
+	/**
+	 * The number of slots in the decoded instruction cache of a script. Must
+	 * be a power of two.
+	 */
+	kDecodedInstructionCacheSize = 2048
+};
+
+/**
+ * A P-machine instruction decoded by readPMachineInstruction.
+ */
+struct PMachineInstruction {
+	uint32 offset;       // offset of the instruction within the script buffer
+	int16 opparams[4];   // decoded instruction parameters
+	byte extOpcode;      // "extended" opcode (lower bit has special meaning)
+	uint16 size;         // length of the instruction in bytes
+
+	PMachineInstruction() : offset(kNoRelocation), extOpcode(0), size(0) {
+		opparams[0] = opparams[1] = opparams[2] = opparams[3] = 0;
+	}
+};
+
 class Script : public SegmentObj {
 private:
 	int _nr; /**< Script number */
@@ -93,6 +115,13 @@ private:
 
 	ObjMap _objects;	/**< Table for objects, contains property variables */
 
+	/**
+	 * Direct-mapped cache of decoded instructions, indexed by the low bits of
+	 * the instruction offset. Allocated the first time code from this script
+	 * is executed, so scripts which only hold data do not pay for it.
+	 */
+	Common::Array<PMachineInstruction> _decodedInstructions;
+
 protected:
 	offsetLookupArrayType _offsetLookupArray; // Table of all elements of currently loaded script, that may get pointed to
 
@@ -117,6 +146,21 @@ public:
 	}
 
 	const byte *getBuf(uint offset = 0) const { return _buf->getUnsafeDataAt(offset); }
+
+	/**
+	 * Returns the instruction at the given offset, decoding it only if it is
+	 * not already in the decoded instruction cache. The returned reference is
+	 * only valid until the next call, since the slot may be reused.
+	 */
+	const PMachineInstruction &getInstruction(const uint32 offset) {
+		if (!_decodedInstructions.empty()) {
+			const PMachineInstruction &instruction = _decodedInstructions[offset & (kDecodedInstructionCacheSize - 1)];
+			if (instruction.offset == offset) {
+				return instruction;
+			}
+		}
+		return decodeInstruction(offset);
+	}
 	SciSpan<const byte> getSpan(uint offset) const { return _buf->subspan(offset); }
 
 	int getScriptNumber() const { return _nr; }
@@ -326,6 +370,12 @@ private:
 
 	bool relocateLocal(SegmentId segment, int location, uint32 offset);
 
+	/**
+	 * Decodes the instruction at the given offset into the decoded instruction
+	 * cache.
+	 */
+	const PMachineInstruction &decodeInstruction(const uint32 offset);
+
 #ifdef ENABLE_SCI32
 	/**
 	 * Gets a pointer to the beginning of the objects in a SCI3 script
@@ -47,6 +47,9 @@ SegManager::SegManager(ResourceManager *resMan, ScriptPatcher *scriptPatcher)
 	_bitmapSegId = 0;
 #endif
 
+	_selectorCache.resize(kSelectorCacheSize);
+	_selectorCacheGeneration = 1;
+
 	createClassTable();
 }
 
@@ -180,6 +183,7 @@ void SegManager::deallocate(SegmentId seg) {
 
 	delete mobj;
 	_heap[actualSegment] = nullptr;
+	invalidateSelectorCache();
 }
 
 bool SegManager::isHeapObject(reg_t pos) const {
@@ -492,6 +496,7 @@ Clone *SegManager::allocateClone(reg_t *addr) {
 	}
 
 	int offset = table->allocEntry();
+	invalidateSelectorCache();
 
 	*addr = make_reg(_clonesSegId, offset);
 	return &table->at(offset);
@@ -1102,6 +1107,7 @@ int SegManager::instantiateScript(int scriptNum, bool applyScriptPatches) {
 	scr->load(scriptNum, _resMan, _scriptPatcher, applyScriptPatches);
 	scr->initializeLocals(this);
 	scr->initializeObjects(this, segmentId, applyScriptPatches);
+	invalidateSelectorCache();
 #ifdef ENABLE_SCI32
 	g_sci->_guestAdditions->instantiateScriptHook(*scr);
 #endif
@@ -45,6 +45,28 @@ enum ScriptLoadType {
 
 class Script;
 
+enum {
+	/**
+	 * The number of slots in the selector lookup cache. Must be a power of two.
+	 */
+	kSelectorCacheSize = 1024
+};
+
+/**
+ * A cached result of lookupSelector.
+ */
+struct SelectorCacheEntry {
+	uint32 generation;      ///< The cache generation in which the entry was filled
+	reg_t obj;              ///< The object the selector was looked up on
+	const Object *objPtr;   ///< The object data at the time of the lookup
+	Selector selector;
+	SelectorType type;
+	int varIndex;           ///< For variable selectors, the property index
+	reg_t funcp;            ///< For method selectors, the method address
+
+	SelectorCacheEntry() : generation(0), obj(NULL_REG), objPtr(nullptr), selector(0), type(kSelectorNone), varIndex(-1), funcp(NULL_REG) {}
+};
+
 class SegManager : public Common::Serializable {
 	friend class Console;
 public:
@@ -126,6 +148,29 @@ public:
 private:
 	void uninstantiateScriptSci0(int script_nr);
 
+public:
+	/**
+	 * Returns the selector cache slot for the given object and selector. The
+	 * slot holds a valid lookup result only if `isSelectorCacheHit` returns
+	 * true for it.
+	 */
+	SelectorCacheEntry &getSelectorCacheEntry(const reg_t obj, const Selector selector) {
+		const uint32 hash = (obj.getSegment() * 31 + obj.getOffset()) * 31 + selector;
+		return _selectorCache[hash & (kSelectorCacheSize - 1)];
+	}
+
+	bool isSelectorCacheHit(const SelectorCacheEntry &entry, const reg_t obj, const Object *objPtr, const Selector selector) const {
+		return entry.generation == _selectorCacheGeneration && entry.obj == obj && entry.objPtr == objPtr && entry.selector == selector;
+	}
+
+	uint32 getSelectorCacheGeneration() const { return _selectorCacheGeneration; }
+
+	/**
+	 * Invalidates all cached selector lookups. Must be called whenever objects
+	 * may be created at addresses which previously held other objects.
+	 */
+	void invalidateSelectorCache() { ++_selectorCacheGeneration; }
+
 public:
 	// TODO: document this
 	reg_t getClassAddress(int classnr, ScriptLoadType lock, uint16 callerSegment, bool applyScriptPatches = true);
@@ -474,6 +519,10 @@ private:
 	SegmentId _nodesSegId; ///< ID of the (a) node segment
 	SegmentId _hunksSegId; ///< ID of the (a) hunk segment
 
+	// Cache of lookupSelector results, see getSelectorCacheEntry()
+	Common::Array<SelectorCacheEntry> _selectorCache;
+	uint32 _selectorCacheGeneration;
+
 	// Statically allocated memory for system strings
 	reg_t _saveDirPtr;
 	reg_t _parserPtr;
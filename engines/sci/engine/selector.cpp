@@ -336,6 +336,26 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 		error("lookupSelector: Attempt to send to non-object or invalid script. Address %04x:%04x", PRINT_REG(obj_location));
 	}
 
+	// Both property and method lookups are linear searches, which may walk up
+	// the whole class hierarchy, so remember the results. The cache can be
+	// disabled from the debugger to rule it out when tracking down bugs.
+	const bool useCache = !g_sci->_debugState.disableVMCaches;
+	SelectorCacheEntry &cacheEntry = segMan->getSelectorCacheEntry(obj_location, selectorId);
+	if (useCache && segMan->isSelectorCacheHit(cacheEntry, obj_location, obj, selectorId)) {
+		if (cacheEntry.type == kSelectorVariable) {
+			if (varp) {
+				varp->obj = obj_location;
+				varp->varindex = cacheEntry.varIndex;
+			}
+		} else if (cacheEntry.type == kSelectorMethod) {
+			if (fptr)
+				*fptr = cacheEntry.funcp;
+		}
+		return cacheEntry.type;
+	}
+
+	SelectorType type = kSelectorNone;
+	reg_t funcp = NULL_REG;
 	int index = obj->locateVarSelector(segMan, selectorId);
 
 	if (index >= 0) {
@@ -344,23 +364,36 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 			varp->obj = obj_location;
 			varp->varindex = index;
 		}
-		return kSelectorVariable;
+		type = kSelectorVariable;
 	} else {
 		// Check if it's a method, with recursive lookup in superclasses
-		while (obj) {
-			index = obj->funcSelectorPosition(selectorId);
-			if (index >= 0) {
+		const Object *methodObj = obj;
+		while (methodObj) {
+			const int methodIndex = methodObj->funcSelectorPosition(selectorId);
+			if (methodIndex >= 0) {
+				funcp = methodObj->getFunction(methodIndex);
 				if (fptr)
-					*fptr = obj->getFunction(index);
+					*fptr = funcp;
 
-				return kSelectorMethod;
+				type = kSelectorMethod;
+				break;
 			} else {
-				obj = segMan->getObject(obj->getSuperClassSelector());
+				methodObj = segMan->getObject(methodObj->getSuperClassSelector());
 			}
 		}
+	}
 
-		return kSelectorNone;
+	if (useCache) {
+		cacheEntry.generation = segMan->getSelectorCacheGeneration();
+		cacheEntry.obj = obj_location;
+		cacheEntry.objPtr = obj;
+		cacheEntry.selector = selectorId;
+		cacheEntry.type = type;
+		cacheEntry.varIndex = index;
+		cacheEntry.funcp = funcp;
 	}
+
+	return type;
 }
 
 } // End of namespace Sci
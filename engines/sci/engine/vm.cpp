@@ -119,6 +119,13 @@ static bool validate_variable(reg_t *r, reg_t *stack_base, int type, int max, in
 }
 
 static reg_t read_var(EngineState *s, int type, int index) {
+	// Fast path for the common case of reading an initialized, valid variable
+	if (index >= 0 && index < s->variablesMax[type]) {
+		const reg_t &value = s->variables[type][index];
+		if (value.getSegment() != kUninitializedSegment)
+			return value;
+	}
+
 	if (validate_variable(s->variables[type], s->stack_base, type, s->variablesMax[type], index)) {
 		if (s->variables[type][index].getSegment() == kUninitializedSegment) {
 			switch (type) {
@@ -164,6 +171,14 @@ static reg_t read_var(EngineState *s, int type, int index) {
 }
 
 static void write_var(EngineState *s, int type, int index, reg_t value) {
+	// Fast path for writing an initialized value into a valid variable. Writes
+	// to globals always take the slow path, as they may need to be synced to
+	// ScummVM by the guest additions.
+	if (type != VAR_GLOBAL && index >= 0 && index < s->variablesMax[type] && value.getSegment() != kUninitializedSegment) {
+		s->variables[type][index] = value;
+		return;
+	}
+
 	if (validate_variable(s->variables[type], s->stack_base, type, s->variablesMax[type], index)) {
 
 		// If we are writing an uninitialized value into a temp, we remove the uninitialized segment
@@ -624,9 +639,19 @@ void run_vm(EngineState *s) {
 			error("run_vm(): program counter gone astray, addr: %d, code buffer size: %d",
 			s->xs->addr.pc.getOffset(), scr->getBufSize());
 
-		// Get opcode
+		// Get opcode. Script code is never modified once loaded, so each
+		// instruction only needs to be decoded once.
 		byte extOpcode;
-		s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
+		if (g_sci->_debugState.disableVMCaches) {
+			s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
+		} else {
+			// The instruction is copied, as nested VM invocations may evict it
+			// from the cache while the instruction is still being executed
+			const PMachineInstruction &instruction = scr->getInstruction(s->xs->addr.pc.getOffset());
+			extOpcode = instruction.extOpcode;
+			memcpy(opparams, instruction.opparams, sizeof(opparams));
+			s->xs->addr.pc.incOffset(instruction.size);
+		}
 		const byte opcode = extOpcode >> 1;
 		//debug("%s: %d, %d, %d, %d, acc = %04x:%04x, script %d, local script %d", opcodeNames[opcode], opparams[0], opparams[1], opparams[2], opparams[3], PRINT_REG(s->r_acc), scr->getScriptNumber(), local_script->getScriptNumber());
 
@@ -33,6 +33,7 @@
 #include "graphics/larryScale.h"
 #include "common/config-manager.h"
 #include "common/gui_options.h"
+#include "common/system.h"
 
 namespace Sci {
 #pragma mark CelScaler
@@ -84,13 +85,27 @@ const CelScalerTable &CelScaler::getScalerTable(const Ratio &scaleX, const Ratio
 #pragma mark -
 #pragma mark CelObj
 bool CelObj::_drawBlackLines = false;
+CelSkipRowDrawer CelObj::_drawSkipRow = drawSkipRowGeneric;
+CelMapRowDrawer CelObj::_drawMapRow = drawMapRowGeneric;
 
 void CelObj::init() {
 	CelObj::deinit();
 	_drawBlackLines = false;
 	_nextCacheId = 1;
+	_nextScaledCacheId = 1;
 	_scaler = new CelScaler();
 	_cache = new CelCache(100);
+	_scaledCache = new CelScaledCache(kCelScaledCacheEntries);
+	_scaledCacheSize = 0;
+
+	_drawSkipRow = drawSkipRowGeneric;
+	_drawMapRow = drawMapRowGeneric;
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+		_drawSkipRow = drawSkipRowSSE2;
+		_drawMapRow = drawMapRowSSE2;
+	}
+#endif
 }
 
 void CelObj::deinit() {
@@ -98,6 +113,35 @@ void CelObj::deinit() {
 	_scaler = nullptr;
 	delete _cache;
 	_cache = nullptr;
+	delete _scaledCache;
+	_scaledCache = nullptr;
+	_scaledCacheSize = 0;
+}
+
+void drawSkipRowGeneric(byte *target, const byte *source, int16 width, const uint8 skipColor) {
+	while (width--) {
+		const byte pixel = *source++;
+		if (pixel != skipColor) {
+			*target = pixel;
+		}
+		++target;
+	}
+}
+
+bool drawMapRowGeneric(byte *target, const byte *source, int16 width, const uint8 skipColor, const uint8 remapStartColor) {
+	bool hasRemap = false;
+	while (width--) {
+		const byte pixel = *source++;
+		if (pixel != skipColor) {
+			if (pixel < remapStartColor) {
+				*target = pixel;
+			} else {
+				hasRemap = true;
+			}
+		}
+		++target;
+	}
+	return hasRemap;
 }
 
 #pragma mark -
@@ -105,6 +149,10 @@ void CelObj::deinit() {
 
 template<bool FLIP, typename READER>
 struct SCALER_NoScale {
+	// Unflipped rows are read sequentially, so they can be drawn a whole row
+	// at a time
+	static const bool kLinearRows = !FLIP;
+
 #ifndef RELEASE_BUILD
 	const byte *_rowEdge;
 #endif
@@ -154,10 +202,16 @@ struct SCALER_NoScale {
 			return *_row++;
 		}
 	}
+
+	inline const byte *getRow() const {
+		return _row;
+	}
 };
 
 template<bool FLIP, typename READER>
 struct SCALER_Scale {
+	static const bool kLinearRows = false;
+
 #ifndef RELEASE_BUILD
 	int16 _minX;
 	int16 _maxX;
@@ -321,6 +375,51 @@ int16 SCALER_Scale<FLIP, READER>::_valuesX[kCelScalerTableSize];
 template<bool FLIP, typename READER>
 int16 SCALER_Scale<FLIP, READER>::_valuesY[kCelScalerTableSize];
 
+/**
+ * Scaler that reads pixels which were already scaled into the scaled cel
+ * cache. `left` and `top` give the screen position of the first cached pixel.
+ */
+struct SCALER_Cached {
+	static const bool kLinearRows = true;
+
+#ifndef RELEASE_BUILD
+	const byte *_rowEdge;
+#endif
+	const byte *_row;
+	const CelScaledCacheEntry &_entry;
+	const int16 _left;
+	const int16 _top;
+
+	SCALER_Cached(const CelScaledCacheEntry &entry, const int16 left, const int16 top) :
+	_row(nullptr),
+	_entry(entry),
+	_left(left),
+	_top(top) {}
+
+	inline void setTarget(const int16 x, const int16 y) {
+		const int16 pitch = _entry.rect.width();
+		_row = _entry.pixels.data() + (y - _top) * pitch;
+#ifndef RELEASE_BUILD
+		_rowEdge = _row + pitch;
+#endif
+		_row += x - _left;
+#ifndef RELEASE_BUILD
+		assert(_row < _rowEdge);
+#endif
+	}
+
+	inline byte read() {
+#ifndef RELEASE_BUILD
+		assert(_row != _rowEdge);
+#endif
+		return *_row++;
+	}
+
+	inline const byte *getRow() const {
+		return _row;
+	}
+};
+
 #pragma mark -
 #pragma mark CelObj - Resource readers
 
@@ -475,11 +574,17 @@ inline byte translateMacColor(bool isMacSource, byte color) {
  * remapping data.
  */
 struct MAPPER_NoMD {
+	static const bool kDrawsRows = true;
+
 	inline void draw(byte *target, const byte pixel, const uint8 skipColor, const bool isMacSource) const {
 		if (pixel != skipColor) {
 			*target = translateMacColor(isMacSource, pixel);
 		}
 	}
+
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8 skipColor) const {
+		CelObj::_drawSkipRow(target, source, width, skipColor);
+	}
 };
 
 /**
@@ -487,9 +592,15 @@ struct MAPPER_NoMD {
  * no remapping data.
  */
 struct MAPPER_NoMDNoSkip {
+	static const bool kDrawsRows = true;
+
 	inline void draw(byte *target, const byte pixel, const uint8, const bool isMacSource) const {
 		*target = translateMacColor(isMacSource, pixel);
 	}
+
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8) const {
+		memcpy(target, source, width);
+	}
 };
 
 /**
@@ -497,6 +608,8 @@ struct MAPPER_NoMDNoSkip {
  * remapping data, and remapping enabled.
  */
 struct MAPPER_Map {
+	static const bool kDrawsRows = true;
+
 	inline void draw(byte *target, const byte pixel, const uint8 skipColor, const bool isMacSource) const {
 		if (pixel != skipColor) {
 			// For some reason, SSCI never checks if the source pixel is *above*
@@ -508,6 +621,23 @@ struct MAPPER_Map {
 			}
 		}
 	}
+
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8 skipColor) const {
+		const GfxRemap32 *remap = g_sci->_gfxRemap32;
+		const uint8 startColor = remap->getStartColor();
+		if (!CelObj::_drawMapRow(target, source, width, skipColor, startColor)) {
+			return;
+		}
+
+		// Remapped pixels only depend on the target pixel under them, so they
+		// can be drawn after the other pixels of the row
+		for (int16 x = 0; x < width; ++x) {
+			const byte pixel = source[x];
+			if (pixel != skipColor && pixel >= startColor && remap->remapEnabled(pixel)) {
+				target[x] = remap->remapColor(pixel, target[x]);
+			}
+		}
+	}
 };
 
 /**
@@ -515,6 +645,8 @@ struct MAPPER_Map {
  * remapping data, and remapping disabled.
  */
 struct MAPPER_NoMap {
+	static const bool kDrawsRows = true;
+
 	inline void draw(byte *target, const byte pixel, const uint8 skipColor, const bool isMacSource) const {
 		// For some reason, SSCI never checks if the source pixel is *above* the
 		// range of remaps, so we do not either.
@@ -522,6 +654,10 @@ struct MAPPER_NoMap {
 			*target = translateMacColor(isMacSource, pixel);
 		}
 	}
+
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8 skipColor) const {
+		CelObj::_drawMapRow(target, source, width, skipColor, g_sci->_gfxRemap32->getStartColor());
+	}
 };
 
 void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect) const {
@@ -739,9 +875,217 @@ void CelObj::putCopyInCache(const int cacheIndex) const {
 	entry.id = ++_nextCacheId;
 }
 
+int CelObj::_nextScaledCacheId = 1;
+CelScaledCache *CelObj::_scaledCache = nullptr;
+uint32 CelObj::_scaledCacheSize = 0;
+
+/**
+ * Returns the source coordinate read at the given position of a scaled cel,
+ * relative to the first row or column of the cel. This is the scaler lookup
+ * table of SCALER_Scale, started at `phase` and offset by `lead`.
+ */
+static inline int16 getScaledSource(const Ratio &scale, const int16 phase, const int16 lead, const int16 position) {
+	const int num = scale.getNumerator();
+	const int denom = scale.getDenominator();
+	return (phase + position) * denom / num - phase * denom / num + lead;
+}
+
+/**
+ * Returns the number of scaled rows or columns reading from `size` source rows
+ * or columns.
+ */
+static inline int16 getScaledSize(const Ratio &scale, const int16 phase, const int16 lead, const int16 size) {
+	const int num = scale.getNumerator();
+	const int denom = scale.getDenominator();
+	const int last = size - lead + phase * denom / num;
+	if (last <= 0) {
+		return 0;
+	}
+	return (last * num + denom - 1) / denom - phase;
+}
+
+/**
+ * Computes where a cel drawn with the global scaling pattern starts on one
+ * axis, along with the phase of the pattern and the source coordinate read
+ * there.
+ */
+static void getGlobalScaledOrigin(const Ratio &scale, const int unscaledPosition, int16 &origin, int16 &phase, int16 &lead) {
+	const int num = scale.getNumerator();
+	const int denom = scale.getDenominator();
+
+	// The first target position whose lookup value reaches the unscaled
+	// position; the lookup value at `x` is `floor(x * denom / num)`
+	const int product = unscaledPosition * num;
+	origin = product >= 0 ? (product + denom - 1) / denom : -(-product / denom);
+	phase = origin >= 0 ? origin % num : (num - (-origin % num)) % num;
+	const int value = origin >= 0 ? origin * denom / num : -((-origin * denom + num - 1) / num);
+	lead = value - unscaledPosition;
+}
+
+template<typename READER>
+const CelScaledCacheEntry *CelObj::getScaledCacheEntry(const Ratio &scaleX, const Ratio &scaleY, const Common::Point &scaledPosition, const Common::Rect &targetRect, Common::Point &origin) const {
+	// Only cels backed by immutable resource data can be cached; the pixels of
+	// CelObjMem bitmaps can be changed by scripts at any time
+	if (_info.type != kCelTypeView && _info.type != kCelTypePic) {
+		return nullptr;
+	}
+
+	// LarryScale output depends on the target rect rather than the global
+	// scaling pattern, so it is always generated while drawing
+	if (Common::checkGameGUIOption(GAMEOPTION_LARRYSCALE, ConfMan.get("guioptions")) && ConfMan.getBool("enable_larryscale")) {
+		return nullptr;
+	}
+
+	// Scaled cels are produced from whole rows of source data, so truncated
+	// uncompressed cels cannot be cached without reading out of bounds
+	if (_compressionType == kCelCompressionNone) {
+		const SciSpan<const byte> resource = getResPointer();
+		const uint32 pixelsOffset = resource.getUint32SEAt(_celHeaderOffset + 24);
+		if (resource.size() < pixelsOffset || resource.size() - pixelsOffset < (uint32)_width * _height) {
+			return nullptr;
+		}
+	}
+
+	// With the global scaling pattern, the source pixels read depend on the
+	// position of the cel only through the phase of the pattern where the cel
+	// starts, so a cel moving around still hits the cache; see SCALER_Scale
+	Common::Point phase, lead;
+	if (g_sci->_gfxFrameout->getScriptWidth() == kLowResX) {
+		getGlobalScaledOrigin(scaleX, (scaledPosition.x / scaleX).toInt(), origin.x, phase.x, lead.x);
+		getGlobalScaledOrigin(scaleY, (scaledPosition.y / scaleY).toInt(), origin.y, phase.y, lead.y);
+	} else {
+		origin = scaledPosition;
+	}
+
+	// Only the part of the cel which is drawn gets scaled
+	Common::Rect rect(targetRect);
+	rect.translate(-origin.x, -origin.y);
+	rect.clip(Common::Rect(getScaledSize(scaleX, phase.x, lead.x, _width), getScaledSize(scaleY, phase.y, lead.y, _height)));
+	if (rect.isEmpty()) {
+		return nullptr;
+	}
+
+	int index = -1;
+	int emptyIndex = -1;
+	int oldestIndex = -1;
+	int oldestId = _nextScaledCacheId + 1;
+	for (int i = 0, len = _scaledCache->size(); i < len; ++i) {
+		CelScaledCacheEntry &entry = (*_scaledCache)[i];
+		if (entry.pixels.empty()) {
+			if (emptyIndex == -1) {
+				emptyIndex = i;
+			}
+		} else if (entry.info == _info &&
+				   entry.mirrored == _drawMirrored &&
+				   entry.scaleX == scaleX &&
+				   entry.scaleY == scaleY &&
+				   entry.phase == phase &&
+				   entry.lead == lead) {
+			entry.id = ++_nextScaledCacheId;
+			if (entry.rect.contains(rect)) {
+				return &entry;
+			}
+
+			// Scale the part drawn before again along with the new one
+			rect.extend(entry.rect);
+			index = i;
+			break;
+		} else if (oldestId > entry.id) {
+			oldestId = entry.id;
+			oldestIndex = i;
+		}
+	}
+
+	if (index == -1) {
+		index = emptyIndex != -1 ? emptyIndex : oldestIndex;
+	}
+
+	CelScaledCacheEntry &entry = (*_scaledCache)[index];
+	_scaledCacheSize -= entry.pixels.size();
+	entry.pixels.clear();
+
+	const uint32 size = rect.width() * rect.height();
+	if (size > kCelScaledCacheMaxBytes / 4) {
+		return nullptr;
+	}
+
+	while (_scaledCacheSize + size > kCelScaledCacheMaxBytes) {
+		oldestIndex = -1;
+		oldestId = _nextScaledCacheId + 1;
+		for (int i = 0, len = _scaledCache->size(); i < len; ++i) {
+			const CelScaledCacheEntry &other = (*_scaledCache)[i];
+			if (!other.pixels.empty() && oldestId > other.id) {
+				oldestId = other.id;
+				oldestIndex = i;
+			}
+		}
+
+		CelScaledCacheEntry &oldest = (*_scaledCache)[oldestIndex];
+		_scaledCacheSize -= oldest.pixels.size();
+		oldest.pixels.clear();
+	}
+
+	entry.id = ++_nextScaledCacheId;
+	entry.info = _info;
+	entry.mirrored = _drawMirrored;
+	entry.scaleX = scaleX;
+	entry.scaleY = scaleY;
+	entry.phase = phase;
+	entry.lead = lead;
+	entry.rect = rect;
+	entry.pixels.resize(size);
+	_scaledCacheSize += size;
+
+	Common::Array<int16> valuesX;
+	valuesX.resize(rect.width());
+	const int lastIndex = _width - 1;
+	for (int16 x = 0; x < rect.width(); ++x) {
+		const int16 sourceX = getScaledSource(scaleX, phase.x, lead.x, rect.left + x);
+		valuesX[x] = _drawMirrored ? lastIndex - sourceX : sourceX;
+	}
+
+	READER reader(*this, _width);
+	byte *targetPixel = entry.pixels.data();
+	for (int16 y = rect.top; y < rect.bottom; ++y) {
+		const byte *row = reader.getRow(getScaledSource(scaleY, phase.y, lead.y, y));
+		for (int16 x = 0; x < rect.width(); ++x) {
+			*targetPixel++ = row[valuesX[x]];
+		}
+	}
+
+	return &entry;
+}
+
 #pragma mark -
 #pragma mark CelObj - Drawing
 
+/**
+ * Draws a single row of pixels pixel by pixel through the mapper.
+ */
+template<typename MAPPER, typename SCALER, bool DRAW_ROWS = MAPPER::kDrawsRows && SCALER::kLinearRows>
+struct ROW_RENDERER {
+	static inline void draw(const MAPPER &mapper, SCALER &scaler, byte *targetPixel, const int16 width, const uint8 skipColor, const bool isMacSource) {
+		for (int16 x = 0; x < width; ++x) {
+			mapper.draw(targetPixel++, scaler.read(), skipColor, isMacSource);
+		}
+	}
+};
+
+/**
+ * Draws a single row of pixels at once when the scaler reads source pixels
+ * sequentially and the mapper does not depend on the target pixels.
+ */
+template<typename MAPPER, typename SCALER>
+struct ROW_RENDERER<MAPPER, SCALER, true> {
+	static inline void draw(const MAPPER &mapper, SCALER &scaler, byte *targetPixel, const int16 width, const uint8 skipColor, const bool isMacSource) {
+		if (isMacSource) {
+			ROW_RENDERER<MAPPER, SCALER, false>::draw(mapper, scaler, targetPixel, width, skipColor, isMacSource);
+		} else {
+			mapper.drawRow(targetPixel, scaler.getRow(), width, skipColor);
+		}
+	}
+};
+
 template<typename MAPPER, typename SCALER, bool DRAW_BLACK_LINES>
 struct RENDERER {
 	MAPPER &_mapper;
@@ -770,11 +1114,9 @@ struct RENDERER {
 
 			_scaler.setTarget(targetRect.left, targetRect.top + y);
 
-			for (int16 x = 0; x < targetWidth; ++x) {
-				_mapper.draw(targetPixel++, _scaler.read(), _skipColor, _isMacSource);
-			}
+			ROW_RENDERER<MAPPER, SCALER>::draw(_mapper, _scaler, targetPixel, targetWidth, _skipColor, _isMacSource);
 
-			targetPixel += skipStride;
+			targetPixel += targetWidth + skipStride;
 		}
 	}
 };
@@ -802,6 +1144,34 @@ void CelObj::render(Buffer &target, const Common::Rect &targetRect, const Common
 	}
 }
 
+template<typename MAPPER, typename READER>
+bool CelObj::renderScaledCached(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, const Ratio &scaleX, const Ratio &scaleY) const {
+	Common::Point origin;
+	const CelScaledCacheEntry *entry = getScaledCacheEntry<READER>(scaleX, scaleY, scaledPosition, targetRect, origin);
+	if (entry == nullptr) {
+		return false;
+	}
+
+	Common::Rect cachedRect(entry->rect);
+	cachedRect.translate(origin.x, origin.y);
+
+	if (!cachedRect.contains(targetRect)) {
+		return false;
+	}
+
+	MAPPER mapper;
+	SCALER_Cached scaler(*entry, cachedRect.left, cachedRect.top);
+	if (_drawBlackLines) {
+		RENDERER<MAPPER, SCALER_Cached, true> renderer(mapper, scaler, _skipColor, _isMacSource);
+		renderer.draw(target, targetRect, scaledPosition);
+	} else {
+		RENDERER<MAPPER, SCALER_Cached, false> renderer(mapper, scaler, _skipColor, _isMacSource);
+		renderer.draw(target, targetRect, scaledPosition);
+	}
+
+	return true;
+}
+
 void CelObj::drawHzFlip(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
 	render<MAPPER_NoMap, SCALER_NoScale<true, READER_Compressed> >(target, targetRect, scaledPosition);
 }
@@ -819,6 +1189,10 @@ void CelObj::drawUncompHzFlip(Buffer &target, const Common::Rect &targetRect, co
 }
 
 void CelObj::scaleDraw(Buffer &target, const Ratio &scaleX, const Ratio &scaleY, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
+	if (renderScaledCached<MAPPER_NoMap, READER_Compressed>(target, targetRect, scaledPosition, scaleX, scaleY)) {
+		return;
+	}
+
 	if (_drawMirrored) {
 		render<MAPPER_NoMap, SCALER_Scale<true, READER_Compressed> >(target, targetRect, scaledPosition, scaleX, scaleY);
 	} else {
@@ -827,6 +1201,10 @@ void CelObj::scaleDraw(Buffer &target, const Ratio &scaleX, const Ratio &scaleY,
 }
 
 void CelObj::scaleDrawUncomp(Buffer &target, const Ratio &scaleX, const Ratio &scaleY, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
+	if (renderScaledCached<MAPPER_NoMap, READER_Uncompressed>(target, targetRect, scaledPosition, scaleX, scaleY)) {
+		return;
+	}
+
 	if (_drawMirrored) {
 		render<MAPPER_NoMap, SCALER_Scale<true, READER_Uncompressed> >(target, targetRect, scaledPosition, scaleX, scaleY);
 	} else {
@@ -851,6 +1229,10 @@ void CelObj::drawUncompHzFlipMap(Buffer &target, const Common::Rect &targetRect,
 }
 
 void CelObj::scaleDrawMap(Buffer &target, const Ratio &scaleX, const Ratio &scaleY, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
+	if (renderScaledCached<MAPPER_Map, READER_Compressed>(target, targetRect, scaledPosition, scaleX, scaleY)) {
+		return;
+	}
+
 	if (_drawMirrored) {
 		render<MAPPER_Map, SCALER_Scale<true, READER_Compressed> >(target, targetRect, scaledPosition, scaleX, scaleY);
 	} else {
@@ -859,6 +1241,10 @@ void CelObj::scaleDrawMap(Buffer &target, const Ratio &scaleX, const Ratio &scal
 }
 
 void CelObj::scaleDrawUncompMap(Buffer &target, const Ratio &scaleX, const Ratio &scaleY, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
+	if (renderScaledCached<MAPPER_Map, READER_Uncompressed>(target, targetRect, scaledPosition, scaleX, scaleY)) {
+		return;
+	}
+
 	if (_drawMirrored) {
 		render<MAPPER_Map, SCALER_Scale<true, READER_Uncompressed> >(target, targetRect, scaledPosition, scaleX, scaleY);
 	} else {
@@ -898,6 +1284,10 @@ void CelObj::scaleDrawNoMD(Buffer &target, const Ratio &scaleX, const Ratio &sca
 		return;
 	}
 
+	if (renderScaledCached<MAPPER_NoMD, READER_Compressed>(target, targetRect, scaledPosition, scaleX, scaleY)) {
+		return;
+	}
+
 	if (_drawMirrored)
 		render<MAPPER_NoMD, SCALER_Scale<true, READER_Compressed> >(target, targetRect, scaledPosition, scaleX, scaleY);
 	else
@@ -912,6 +1302,10 @@ void CelObj::scaleDrawUncompNoMD(Buffer &target, const Ratio &scaleX, const Rati
 		return;
 	}
 
+	if (renderScaledCached<MAPPER_NoMD, READER_Uncompressed>(target, targetRect, scaledPosition, scaleX, scaleY)) {
+		return;
+	}
+
 	if (_drawMirrored) {
 		render<MAPPER_NoMD, SCALER_Scale<true, READER_Uncompressed> >(target, targetRect, scaledPosition, scaleX, scaleY);
 	} else {
@@ -148,6 +148,91 @@ struct CelCacheEntry {
 
 typedef Common::Array<CelCacheEntry> CelCache;
 
+enum {
+	/**
+	 * The maximum number of scaled cels held in the scaled cel cache.
+	 */
+	kCelScaledCacheEntries = 32,
+
+	/**
+	 * The maximum number of bytes of scaled pixel data held in the scaled cel
+	 * cache.
+	 */
+	kCelScaledCacheMaxBytes = 8 * 1024 * 1024
+};
+
+/**
+ * A pre-scaled copy of the source pixels of a view or pic cel. Entries hold
+ * unmapped pixel data, so remapping and skip color handling still happen when
+ * the cached pixels are drawn to the target buffer.
+ */
+struct CelScaledCacheEntry {
+	/**
+	 * A monotonically increasing cache ID used to identify the least recently
+	 * used item in the cache for replacement.
+	 */
+	int id;
+
+	/**
+	 * The cel that was scaled.
+	 */
+	CelInfo32 info;
+
+	/**
+	 * Whether the cached pixels are horizontally mirrored.
+	 */
+	bool mirrored;
+
+	/**
+	 * The scaling ratios used to generate the cached pixels.
+	 */
+	Ratio scaleX, scaleY;
+
+	/**
+	 * The phase of the global scaling pattern at the first pixel of the cel,
+	 * and the source pixel read there. Both are zero when the global scaling
+	 * pattern is not used. Along with the scaling ratios, they determine the
+	 * source pixel of every scaled pixel, wherever the cel is drawn.
+	 */
+	Common::Point phase, lead;
+
+	/**
+	 * The area covered by the cached pixels, relative to the first pixel of
+	 * the cel. Only the parts of the cel which were drawn are scaled.
+	 */
+	Common::Rect rect;
+
+	/**
+	 * The scaled pixel data, `rect.width()` bytes per row.
+	 */
+	Common::Array<byte> pixels;
+
+	CelScaledCacheEntry() : id(0), mirrored(false) {}
+};
+
+typedef Common::Array<CelScaledCacheEntry> CelScaledCache;
+
+/**
+ * Copies `width` pixels from `source` to `target`, leaving target pixels
+ * untouched wherever the source pixel is `skipColor`.
+ */
+typedef void (*CelSkipRowDrawer)(byte *target, const byte *source, int16 width, uint8 skipColor);
+
+/**
+ * Copies the pixels of `source` below `remapStartColor` to `target`, leaving
+ * target pixels untouched wherever the source pixel is `skipColor` or a remap
+ * color. Returns true if the row contains remap colors, which are left for the
+ * caller to draw.
+ */
+typedef bool (*CelMapRowDrawer)(byte *target, const byte *source, int16 width, uint8 skipColor, uint8 remapStartColor);
+
+void drawSkipRowGeneric(byte *target, const byte *source, int16 width, uint8 skipColor);
+bool drawMapRowGeneric(byte *target, const byte *source, int16 width, uint8 skipColor, uint8 remapStartColor);
+#ifdef SCUMMVM_SSE2
+void drawSkipRowSSE2(byte *target, const byte *source, int16 width, uint8 skipColor);
+bool drawMapRowSSE2(byte *target, const byte *source, int16 width, uint8 skipColor, uint8 remapStartColor);
+#endif
+
 #pragma mark -
 #pragma mark CelScaler
 
@@ -262,6 +347,18 @@ protected:
 public:
 	static CelScaler *_scaler;
 
+	/**
+	 * The row drawing routine used for transparent cels without remap data,
+	 * selected according to the features of the host CPU.
+	 */
+	static CelSkipRowDrawer _drawSkipRow;
+
+	/**
+	 * The row drawing routine used for cels with remap data, selected
+	 * according to the features of the host CPU.
+	 */
+	static CelMapRowDrawer _drawMapRow;
+
 	/**
 	 * The basic identifying information for this cel. This information
 	 * effectively acts as a composite key for a cel object, and any cel object
@@ -420,6 +517,14 @@ private:
 	template<typename MAPPER, typename SCALER>
 	void render(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, const Ratio &scaleX, const Ratio &scaleY) const;
 
+	/**
+	 * Draws the cel from the scaled cel cache, scaling and caching it first if
+	 * necessary. Returns false if the cel cannot be drawn from the cache, in
+	 * which case the caller must fall back to scaling while drawing.
+	 */
+	template<typename MAPPER, typename READER>
+	bool renderScaledCached(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, const Ratio &scaleX, const Ratio &scaleY) const;
+
 	void drawHzFlip(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition) const;
 	void drawNoFlip(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition) const;
 	void drawUncompNoFlip(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition) const;
@@ -474,6 +579,32 @@ protected:
 	 * Puts a copy of this CelObj into the cache at the given cache index.
 	 */
 	void putCopyInCache(int index) const;
+
+	/**
+	 * A monotonically increasing cache ID used to identify the least recently
+	 * used item in the scaled cel cache for replacement.
+	 */
+	static int _nextScaledCacheId;
+
+	/**
+	 * A cache of pre-scaled view and pic cels, used to avoid running every
+	 * pixel through the scaler lookup tables on every frame.
+	 */
+	static CelScaledCache *_scaledCache;
+
+	/**
+	 * The number of bytes of pixel data currently held in the scaled cel cache.
+	 */
+	static uint32 _scaledCacheSize;
+
+	/**
+	 * Retrieves the scaled cel cache entry for this cel at the given scale,
+	 * scaling the part of it within `targetRect` if it is not already cached.
+	 * `origin` receives the screen position of the first pixel of the cel.
+	 * Returns nullptr if this cel cannot be cached.
+	 */
+	template<typename READER>
+	const CelScaledCacheEntry *getScaledCacheEntry(const Ratio &scaleX, const Ratio &scaleY, const Common::Point &scaledPosition, const Common::Rect &targetRect, Common::Point &origin) const;
 };
 
 #pragma mark -
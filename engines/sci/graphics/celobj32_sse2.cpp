@@ -0,0 +1,99 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "sci/graphics/celobj32.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Sci {
+
+void drawSkipRowSSE2(byte *target, const byte *source, int16 width, const uint8 skipColor) {
+	const __m128i skip = _mm_set1_epi8((char)skipColor);
+
+	for (; width >= 16; width -= 16, source += 16, target += 16) {
+		const __m128i pixels = _mm_loadu_si128((const __m128i *)source);
+		const __m128i mask = _mm_cmpeq_epi8(pixels, skip);
+		const int skipBits = _mm_movemask_epi8(mask);
+
+		if (skipBits == 0) {
+			_mm_storeu_si128((__m128i *)target, pixels);
+		} else if (skipBits != 0xFFFF) {
+			const __m128i background = _mm_loadu_si128((const __m128i *)target);
+			_mm_storeu_si128((__m128i *)target, _mm_or_si128(_mm_and_si128(mask, background), _mm_andnot_si128(mask, pixels)));
+		}
+	}
+
+	drawSkipRowGeneric(target, source, width, skipColor);
+}
+
+bool drawMapRowSSE2(byte *target, const byte *source, int16 width, const uint8 skipColor, const uint8 remapStartColor) {
+	const __m128i skip = _mm_set1_epi8((char)skipColor);
+	const __m128i startColor = _mm_set1_epi8((char)remapStartColor);
+	int remapBits = 0;
+
+	for (; width >= 16; width -= 16, source += 16, target += 16) {
+		const __m128i pixels = _mm_loadu_si128((const __m128i *)source);
+		const __m128i skipMask = _mm_cmpeq_epi8(pixels, skip);
+		// Unsigned pixel >= remapStartColor
+		const __m128i remapMask = _mm_cmpeq_epi8(_mm_max_epu8(pixels, startColor), pixels);
+		const __m128i mask = _mm_or_si128(skipMask, remapMask);
+		const int keepBits = _mm_movemask_epi8(mask);
+
+		if (keepBits == 0) {
+			_mm_storeu_si128((__m128i *)target, pixels);
+		} else {
+			if (keepBits != 0xFFFF) {
+				const __m128i background = _mm_loadu_si128((const __m128i *)target);
+				_mm_storeu_si128((__m128i *)target, _mm_or_si128(_mm_and_si128(mask, background), _mm_andnot_si128(mask, pixels)));
+			}
+			remapBits |= _mm_movemask_epi8(_mm_andnot_si128(skipMask, remapMask));
+		}
+	}
+
+	const bool hasRemap = drawMapRowGeneric(target, source, width, skipColor, remapStartColor);
+	return hasRemap || remapBits != 0;
+}
+
+} // End of namespace Sci
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
@@ -124,6 +124,11 @@ MODULE_OBJS += \
 	sound/audio32.o \
 	sound/decoders/sol.o \
 	video/robot_decoder.o
+
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	graphics/celobj32_sse2.o
+endif
 endif
 
 # This module can be built as a plugin
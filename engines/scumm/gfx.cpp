@@ -513,14 +513,53 @@ void ScummEngine::markRectAsDirty(VirtScreenNumber virt, int left, int right, in
 		rp = _gdi->_numStrips - 1;
 
 	while (lp <= rp) {
-		if (top < vs->tdirty[lp])
-			vs->tdirty[lp] = top;
-		if (bottom > vs->bdirty[lp])
-			vs->bdirty[lp] = bottom;
+		vs->markStripDirty(lp, top, bottom);
 		lp++;
 	}
 }
 
+void VirtScreen::markStripDirty(int strip, int top, int bottom) {
+	// Updates at most this many rows apart are merged into one range, as
+	// blitting a few clean rows is cheaper than issuing another copy.
+	const int mergeGap = 8;
+
+	if (bottom <= top)
+		return;
+
+	uint16 &t1 = tdirty[strip];
+	uint16 &b1 = bdirty[strip];
+	uint16 &t2 = tdirty2[strip];
+	uint16 &b2 = bdirty2[strip];
+
+	if (b1 <= t1) {
+		t1 = top;
+		b1 = bottom;
+	} else if (top <= b1 + mergeGap && bottom + mergeGap >= t1) {
+		t1 = MIN<int>(t1, top);
+		b1 = MAX<int>(b1, bottom);
+	} else if (b2 <= t2) {
+		t2 = top;
+		b2 = bottom;
+	} else {
+		const int growth1 = MAX<int>(b1, bottom) - MIN<int>(t1, top) - (b1 - t1);
+		const int growth2 = MAX<int>(b2, bottom) - MIN<int>(t2, top) - (b2 - t2);
+		if (growth1 <= growth2) {
+			t1 = MIN<int>(t1, top);
+			b1 = MAX<int>(b1, bottom);
+		} else {
+			t2 = MIN<int>(t2, top);
+			b2 = MAX<int>(b2, bottom);
+		}
+	}
+
+	// Fold the secondary range back in once the two ranges come close
+	if (b2 > t2 && t2 <= b1 + mergeGap && b2 + mergeGap >= t1) {
+		t1 = MIN(t1, t2);
+		b1 = MAX(b1, b2);
+		t2 = b2 = 0;
+	}
+}
+
 /**
  * Update all dirty screen areas. This method blits all of the internal engine
  * graphics to the actual display, as needed. In addition, the 'shaking'
@@ -591,32 +630,38 @@ void ScummEngine::updateDirtyScreen(VirtScreenNumber slot) {
 	if (vs->h == 0)
 		return;
 
-	int i;
-	int w = 8;
-	int start = 0;
-
-	for (i = 0; i < _gdi->_numStrips; i++) {
-		if (vs->bdirty[i]) {
-			const int top = vs->tdirty[i];
-			const int bottom = vs->bdirty[i];
-			vs->tdirty[i] = vs->h;
-			vs->bdirty[i] = 0;
-			if (i != (_gdi->_numStrips - 1) && vs->bdirty[i + 1] == bottom && vs->tdirty[i + 1] == top) {
-				// Simple optimizations: if two or more neighboring strips
-				// form one bigger rectangle, coalesce them.
-				w += 8;
-				continue;
-			}
+	// The primary dirty ranges are blitted first, then the secondary ones
+	// recorded by markStripDirty() for strips with two distant updates.
+	for (int pass = 0; pass < 2; pass++) {
+		uint16 *tdirty = pass ? vs->tdirty2 : vs->tdirty;
+		uint16 *bdirty = pass ? vs->bdirty2 : vs->bdirty;
+		const uint16 clean = pass ? 0 : vs->h;
+		int w = 8;
+		int start = 0;
+
+		for (int i = 0; i < _gdi->_numStrips; i++) {
+			if (bdirty[i]) {
+				const int top = tdirty[i];
+				const int bottom = bdirty[i];
+				tdirty[i] = clean;
+				bdirty[i] = 0;
+				if (i != (_gdi->_numStrips - 1) && bdirty[i + 1] == bottom && tdirty[i + 1] == top) {
+					// Simple optimizations: if two or more neighboring strips
+					// form one bigger rectangle, coalesce them.
+					w += 8;
+					continue;
+				}
 #ifndef DISABLE_TOWNS_DUAL_LAYER_MODE
-			if (_game.platform == Common::kPlatformFMTowns && vs->number == kBannerVirtScreen) {
-				int scl = _textSurfaceMultiplier;
-				towns_drawStripToScreen(vs, start * 8 * scl, (vs->topline + top) * scl, start * 8 * scl, top * scl, w * scl, bottom - top);
-			} else
+				if (_game.platform == Common::kPlatformFMTowns && vs->number == kBannerVirtScreen) {
+					int scl = _textSurfaceMultiplier;
+					towns_drawStripToScreen(vs, start * 8 * scl, (vs->topline + top) * scl, start * 8 * scl, top * scl, w * scl, bottom - top);
+				} else
 #endif
-				drawStripToScreen(vs, start * 8, w, top, bottom);
-			w = 8;
+					drawStripToScreen(vs, start * 8, w, top, bottom);
+				w = 8;
+			}
+			start = i + 1;
 		}
-		start = i + 1;
 	}
 }
 
@@ -724,35 +769,47 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 #ifdef USE_ARM_GFX_ASM
 			asmDrawStripToScreen(height, width, text, src, _compositeBuf, vs->pitch, width, _textSurface.pitch);
 #else
-			// We blit four pixels at a time, for improved performance.
-			const uint32 *src32 = (const uint32 *)src;
-			uint32 *dst32 = (uint32 *)_compositeBuf;
-
-			vsPitch >>= 2;
-
-			const uint32 *text32 = (const uint32 *)text;
-			const int textPitch = (_textSurface.pitch - width * m) >> 2;
-			for (int h = height * m; h > 0; --h) {
-				for (int w = width * m; w > 0; w -= 4) {
-					uint32 temp = *text32++;
-
-					// Generate a byte mask for those text pixels (bytes) with
-					// value CHARSET_MASK_TRANSPARENCY. In the end, each byte
-					// in mask will be either equal to 0x00 or 0xFF.
-					// Doing it this way avoids branches and bytewise operations,
-					// at the cost of readability ;).
-					uint32 mask = temp ^ CHARSET_MASK_TRANSPARENCY_32;
-					mask = (((mask & 0x7f7f7f7f) + 0x7f7f7f7f) | mask) & 0x80808080;
-					mask = ((mask >> 7) + 0x7f7f7f7f) ^ 0x80808080;
-
-					// The following line is equivalent to this code:
-					//   *dst32++ = (*src32++ & mask) | (temp & ~mask);
-					// However, some compilers can generate somewhat better
-					// machine code for this equivalent statement:
-					*dst32++ = ((temp ^ *src32++) & mask) ^ temp;
+#ifdef SCUMMVM_AVX2
+			if (m == 1 && _system->hasFeature(OSystem::kFeatureCpuAVX2)) {
+				compositeTextStripAVX2(_compositeBuf, (const byte *)src, vs->pitch, (const byte *)text, _textSurface.pitch, width, height);
+			} else
+#endif
+#ifdef SCUMMVM_SSE2
+			if (m == 1 && _system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+				compositeTextStripSSE2(_compositeBuf, (const byte *)src, vs->pitch, (const byte *)text, _textSurface.pitch, width, height);
+			} else
+#endif
+			{
+				// We blit four pixels at a time, for improved performance.
+				const uint32 *src32 = (const uint32 *)src;
+				uint32 *dst32 = (uint32 *)_compositeBuf;
+
+				vsPitch >>= 2;
+
+				const uint32 *text32 = (const uint32 *)text;
+				const int textPitch = (_textSurface.pitch - width * m) >> 2;
+				for (int h = height * m; h > 0; --h) {
+					for (int w = width * m; w > 0; w -= 4) {
+						uint32 temp = *text32++;
+
+						// Generate a byte mask for those text pixels (bytes) with
+						// value CHARSET_MASK_TRANSPARENCY. In the end, each byte
+						// in mask will be either equal to 0x00 or 0xFF.
+						// Doing it this way avoids branches and bytewise operations,
+						// at the cost of readability ;).
+						uint32 mask = temp ^ CHARSET_MASK_TRANSPARENCY_32;
+						mask = (((mask & 0x7f7f7f7f) + 0x7f7f7f7f) | mask) & 0x80808080;
+						mask = ((mask >> 7) + 0x7f7f7f7f) ^ 0x80808080;
+
+						// The following line is equivalent to this code:
+						//   *dst32++ = (*src32++ & mask) | (temp & ~mask);
+						// However, some compilers can generate somewhat better
+						// machine code for this equivalent statement:
+						*dst32++ = ((temp ^ *src32++) & mask) ^ temp;
+					}
+					src32 += vsPitch;
+					text32 += textPitch;
 				}
-				src32 += vsPitch;
-				text32 += textPitch;
 			}
 #endif
 		}
@@ -1902,8 +1959,7 @@ void ScummEngine_v5::drawFlashlight() {
 	for (int i = _flashlight.x / 8; i < (_flashlight.x + _flashlight.w) / 8; i++) {
 		assert(0 <= i && i < _gdi->_numStrips);
 		setGfxUsageBit(_screenStartStrip + i, USAGE_BIT_DIRTY);
-		vs->tdirty[i] = 0;
-		vs->bdirty[i] = vs->h;
+		vs->setStripDirtyRange(i, 0, vs->h);
 	}
 
 	byte *bgbak;
@@ -2382,11 +2438,7 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	if (limit > _numStrips - sx)
 		limit = _numStrips - sx;
 	for (int k = 0; k < limit; ++k, ++stripnr, ++sx, ++x) {
-		if (y < vs->tdirty[sx])
-			vs->tdirty[sx] = y;
-
-		if (y + height > vs->bdirty[sx])
-			vs->bdirty[sx] = y + height;
+		vs->markStripDirty(sx, y, y + height);
 
 		// In the case of a double buffered virtual screen, we draw to
 		// the backbuffer, otherwise to the primary surface memory.
@@ -2949,11 +3001,7 @@ void Gdi::resetBackground(int top, int bottom, int strip) {
 
 	assert(0 <= strip && strip < _numStrips);
 
-	if (top < vs->tdirty[strip])
-		vs->tdirty[strip] = top;
-
-	if (bottom > vs->bdirty[strip])
-		vs->bdirty[strip] = bottom;
+	vs->markStripDirty(strip, top, bottom);
 
 	bgbak_ptr = (byte *)vs->backBuf + top * vs->pitch + (strip + vs->xstart/8) * 8 * vs->format.bytesPerPixel;
 	backbuff_ptr = (byte *)vs->getBasePtr((strip + vs->xstart/8) * 8, top);
@@ -4591,8 +4639,7 @@ void ScummEngine::transitionEffect(int a) {
 			if (t == b) {
 				while (l <= r) {
 					if (l >= 0 && l < _gdi->_numStrips && t < bottom) {
-						_virtscr[kMainVirtScreen].tdirty[l] = _screenTop + t * 8;
-						_virtscr[kMainVirtScreen].bdirty[l] = _screenTop + (b + 1) * 8;
+						_virtscr[kMainVirtScreen].setStripDirtyRange(l, _screenTop + t * 8, _screenTop + (b + 1) * 8);
 					}
 					l++;
 				}
@@ -4603,8 +4650,7 @@ void ScummEngine::transitionEffect(int a) {
 					b = bottom;
 				if (t < 0)
 					t = 0;
-				_virtscr[kMainVirtScreen].tdirty[l] = _screenTop + t * 8;
-				_virtscr[kMainVirtScreen].bdirty[l] = _screenTop + (b + 1) * 8;
+				_virtscr[kMainVirtScreen].setStripDirtyRange(l, _screenTop + t * 8, _screenTop + (b + 1) * 8);
 			}
 			updateDirtyScreen(kMainVirtScreen);
 		}
@@ -240,6 +240,16 @@ struct VirtScreen : Graphics::Surface {
 	 */
 	uint16 bdirty[80 + 1];
 
+	/**
+	 * Secondary dirty range for each strip. When a strip receives two
+	 * updates far apart vertically (e.g. a verb at the bottom and an actor
+	 * near the top), the second one is tracked here instead of stretching
+	 * tdirty/bdirty over everything in between. The range is empty when
+	 * bdirty2 is not greater than tdirty2.
+	 */
+	uint16 tdirty2[80 + 1];
+	uint16 bdirty2[80 + 1];
+
 	void clear() {
 		// FIXME: Call Graphics::Surface clear / constructor?
 		number = kMainVirtScreen;
@@ -249,6 +259,8 @@ struct VirtScreen : Graphics::Surface {
 		backBuf = nullptr;
 		for (uint i = 0; i < ARRAYSIZE(tdirty); i++) tdirty[i] = 0;
 		for (uint i = 0; i < ARRAYSIZE(bdirty); i++) bdirty[i] = 0;
+		for (uint i = 0; i < ARRAYSIZE(tdirty2); i++) tdirty2[i] = 0;
+		for (uint i = 0; i < ARRAYSIZE(bdirty2); i++) bdirty2[i] = 0;
 	}
 
 	/**
@@ -263,9 +275,36 @@ struct VirtScreen : Graphics::Surface {
 		for (int i = 0; i < 80 + 1; i++) {
 			tdirty[i] = top;
 			bdirty[i] = bottom;
+			tdirty2[i] = 0;
+			bdirty2[i] = 0;
 		}
 	}
 
+	/**
+	 * Make the rows [top, bottom) the only dirty rows of the given strip,
+	 * dropping its secondary range.
+	 */
+	void setStripDirtyRange(int strip, int top, int bottom) {
+		tdirty[strip] = top;
+		bdirty[strip] = bottom;
+		tdirty2[strip] = 0;
+		bdirty2[strip] = 0;
+	}
+
+	/**
+	 * Add the rows [top, bottom) of the given strip to its dirty ranges.
+	 * Updates close to an existing range are merged into it; otherwise
+	 * the update goes into whichever range grows the least.
+	 */
+	void markStripDirty(int strip, int top, int bottom);
+
+	/** Returns true if any row in [top, bottom] of the given strip is dirty. */
+	bool isStripDirty(int strip, int top, int bottom) const {
+		if (tdirty[strip] < h && top <= bdirty[strip] && bottom >= tdirty[strip])
+			return true;
+		return bdirty2[strip] > tdirty2[strip] && top <= bdirty2[strip] && bottom >= tdirty2[strip];
+	}
+
 	byte *getPixels(int x, int y) const {
 		return (byte *)pixels + y * pitch + (xstart + x) * format.bytesPerPixel;
 	}
@@ -289,6 +328,13 @@ struct StripTable;
 #define CHARSET_MASK_TRANSPARENCY	 0xFD
 #define CHARSET_MASK_TRANSPARENCY_32 0xFDFDFDFD
 
+#ifdef SCUMMVM_SSE2
+void compositeTextStripSSE2(byte *dst, const byte *src, int srcPitch, const byte *text, int textPitch, int width, int height);
+#endif
+#ifdef SCUMMVM_AVX2
+void compositeTextStripAVX2(byte *dst, const byte *src, int srcPitch, const byte *text, int textPitch, int width, int height);
+#endif
+
 class Gdi {
 protected:
 	ScummEngine *_vm;
@@ -0,0 +1,65 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "scumm/gfx.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Scumm {
+
+void compositeTextStripAVX2(byte *dst, const byte *src, int srcPitch, const byte *text, int textPitch, int width, int height) {
+	const __m256i transparent = _mm256_set1_epi8((char)CHARSET_MASK_TRANSPARENCY);
+
+	for (; height > 0; --height) {
+		int w = 0;
+		for (; w + 32 <= width; w += 32) {
+			const __m256i textPixels = _mm256_loadu_si256((const __m256i *)(text + w));
+			const __m256i mask = _mm256_cmpeq_epi8(textPixels, transparent);
+			const __m256i srcPixels = _mm256_loadu_si256((const __m256i *)(src + w));
+			_mm256_storeu_si256((__m256i *)(dst + w), _mm256_blendv_epi8(textPixels, srcPixels, mask));
+		}
+		for (; w < width; ++w) {
+			dst[w] = (text[w] == CHARSET_MASK_TRANSPARENCY) ? src[w] : text[w];
+		}
+
+		dst += width;
+		src += srcPitch;
+		text += textPitch;
+	}
+}
+
+} // End of namespace Scumm
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
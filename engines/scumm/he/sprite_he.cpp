@@ -1493,7 +1493,7 @@ void Sprite::eraseSprites() {
 
 
 bool Sprite::doesRectIntersectUpdateAreas(const Common::Rect *rectPtr) {
-	int sMin, sMax, y1, y2, minValue;
+	int sMin, sMax, y1, y2;
 	VirtScreen *vs = &_vm->_virtscr[kMainVirtScreen];
 	int strips = _vm->_gdi->_numStrips;
 	int stripsBytes = 8;
@@ -1508,17 +1508,8 @@ bool Sprite::doesRectIntersectUpdateAreas(const Common::Rect *rectPtr) {
 	sMax = MAX(0, MIN(sMax, (strips - 1)));
 
 	for (int i = sMin; i <= sMax; i++) {
-		minValue = vs->tdirty[i];
-		if (minValue >= vs->h)
-			continue;
-
-		if (y2 < minValue)
-			continue;
-
-		if (y1 > vs->bdirty[i])
-			continue;
-
-		return true;
+		if (vs->isStripDirty(i, y1, y2))
+			return true;
 	}
 
 	return false;
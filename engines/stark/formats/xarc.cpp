@@ -27,6 +27,7 @@
 
 #include "common/debug.h"
 #include "common/file.h"
+#include "common/memstream.h"
 #include "common/substream.h"
 
 namespace Stark {
@@ -100,8 +101,32 @@ Common::String XARCMember::readString(Common::ReadStream &stream) {
 }
 
 
+// PRELOADED MEMBER STREAM
+
+/**
+ * A member read from a preloaded archive
+ *
+ * Keeps a reference to the archive data so the stream
+ * remains valid after the archive is unloaded.
+ */
+class XARCMemoryReadStream : public Common::MemoryReadStream {
+public:
+	XARCMemoryReadStream(const Common::SharedPtr<byte> &data, uint32 offset, uint32 length) :
+			Common::MemoryReadStream(data.get() + offset, length, DisposeAfterUse::NO),
+			_data(data) {
+	}
+
+private:
+	Common::SharedPtr<byte> _data;
+};
+
+
 // ARCHIVE
 
+XARCArchive::XARCArchive() :
+		_dataSize(0) {
+}
+
 bool XARCArchive::open(const Common::Path &filename) {
 	Common::File stream;
 	if (!stream.open(filename)) {
@@ -140,6 +165,33 @@ Common::Path XARCArchive::getFilename() const {
 	return _filename;
 }
 
+bool XARCArchive::preload(uint32 maxSize) {
+	Common::File stream;
+	if (!stream.open(_filename)) {
+		return false;
+	}
+
+	uint32 size = stream.size();
+	if (size == 0 || size > maxSize) {
+		return false;
+	}
+
+	byte *data = new byte[size];
+	if (stream.read(data, size) != size) {
+		delete[] data;
+		return false;
+	}
+
+	setData(Common::SharedPtr<byte>(data, Common::ArrayDeleter<byte>()), size);
+	return true;
+}
+
+void XARCArchive::setData(const Common::SharedPtr<byte> &data, uint32 size) {
+	debugC(20, kDebugArchive, "Stark::XARC: \"%s\" is served from memory", _filename.toString(Common::Path::kNativeSeparator).c_str());
+	_data = data;
+	_dataSize = size;
+}
+
 bool XARCArchive::hasFile(const Common::Path &path) const {
 	Common::String name = path.toString();
 	for (Common::ArchiveMemberList::const_iterator it = _members.begin(); it != _members.end(); ++it) {
@@ -205,6 +257,17 @@ Common::SeekableReadStream *XARCArchive::createReadStreamForMember(const Common:
 }
 
 Common::SeekableReadStream *XARCArchive::createReadStreamForMember(const XARCMember *member) const {
+	if (_data) {
+		uint32 offset = member->getOffset();
+		uint32 length = member->getLength();
+		if (offset > _dataSize || length > _dataSize - offset) {
+			warning("Stark::XARC: \"%s\" is truncated", _filename.toString(Common::Path::kNativeSeparator).c_str());
+			return nullptr;
+		}
+
+		return new XARCMemoryReadStream(_data, offset, length);
+	}
+
 	// Open the xarc file
 	Common::File *f = new Common::File;
 	if (!f)
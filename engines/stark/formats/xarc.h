@@ -23,6 +23,7 @@
 #define STARK_ARCHIVE_H
 
 #include "common/archive.h"
+#include "common/ptr.h"
 #include "common/stream.h"
 
 namespace Stark {
@@ -32,9 +33,22 @@ class XARCMember;
 
 class XARCArchive : public Common::Archive {
 public:
+	XARCArchive();
+
 	bool open(const Common::Path &filename);
 	Common::Path getFilename() const;
 
+	/**
+	 * Read the whole archive file in one pass, so that the members
+	 * are then served from memory rather than by reopening the file.
+	 *
+	 * Archives larger than maxSize are left on disk.
+	 */
+	bool preload(uint32 maxSize);
+
+	/** Serve the members from an already read copy of the archive file */
+	void setData(const Common::SharedPtr<byte> &data, uint32 size);
+
 	// Archive API
 	bool hasFile(const Common::Path &path) const;
 	int listMatchingMembers(Common::ArchiveMemberList &list, const Common::Path &pattern, bool matchPathComponents = false) const;
@@ -47,6 +61,9 @@ public:
 private:
 	Common::Path _filename;
 	Common::ArchiveMemberList _members;
+
+	Common::SharedPtr<byte> _data;
+	uint32 _dataSize;
 };
 
 } // End of namespace Formats
@@ -27,6 +27,14 @@
 
 namespace Stark {
 
+// Archives larger than this are read member by member from the disk
+static const uint32 kMaxPreloadSize = 16 * 1024 * 1024;
+
+// Amount of data read ahead of time per frame
+static const uint32 kPrefetchChunkSize = 256 * 1024;
+
+static const uint kMaxPrefetchedArchives = 4;
+
 ArchiveLoader::LoadedArchive::LoadedArchive(const Common::Path& archiveName) :
 		_filename(archiveName),
 		_root(nullptr),
@@ -48,6 +56,10 @@ void ArchiveLoader::LoadedArchive::importResources() {
 	_root = Formats::XRCReader::importTree(&_xarc);
 }
 
+ArchiveLoader::ArchiveLoader() :
+		_prefetchPosition(0) {
+}
+
 ArchiveLoader::~ArchiveLoader() {
 	for (LoadedArchiveList::iterator it = _archives.begin(); it != _archives.end(); it++) {
 		delete *it;
@@ -63,6 +75,14 @@ bool ArchiveLoader::load(const Common::Path &archiveName) {
 	LoadedArchive *archive = new LoadedArchive(archiveName);
 	_archives.push_back(archive);
 
+	// Read the whole archive in one pass instead of reopening it for each member
+	PrefetchedArchive prefetched;
+	if (takePrefetched(archiveName, prefetched)) {
+		archive->getXArc().setData(prefetched.data, prefetched.size);
+	} else {
+		archive->getXArc().preload(kMaxPreloadSize);
+	}
+
 	archive->importResources();
 
 	return true;
@@ -132,12 +152,107 @@ Common::Path ArchiveLoader::buildArchiveName(Resources::Level *level, Resources:
 			error("Unknown level type %d", level->getSubType());
 		}
 	} else {
-		archive = Common::String::format("%02x/%02x/%02x.xarc", level->getIndex(), location->getIndex(), location->getIndex());
+		return buildLocationArchiveName(level->getIndex(), location->getIndex());
 	}
 
 	return Common::Path(archive, '/');
 }
 
+Common::Path ArchiveLoader::buildLocationArchiveName(uint16 levelIndex, uint16 locationIndex) const {
+	Common::String archive = Common::String::format("%02x/%02x/%02x.xarc", levelIndex, locationIndex, locationIndex);
+	return Common::Path(archive, '/');
+}
+
+void ArchiveLoader::prefetch(const Common::Path &archiveName) {
+	if (hasArchive(archiveName)) {
+		return;
+	}
+
+	for (PrefetchedArchiveList::const_iterator it = _prefetchQueue.begin(); it != _prefetchQueue.end(); it++) {
+		if (it->filename == archiveName) {
+			return;
+		}
+	}
+
+	for (PrefetchedArchiveList::const_iterator it = _prefetched.begin(); it != _prefetched.end(); it++) {
+		if (it->filename == archiveName) {
+			return;
+		}
+	}
+
+	PrefetchedArchive prefetched;
+	prefetched.filename = archiveName;
+	prefetched.size = 0;
+	_prefetchQueue.push_back(prefetched);
+}
+
+void ArchiveLoader::clearPrefetch() {
+	_prefetchFile.close();
+	_prefetchQueue.clear();
+	_prefetched.clear();
+}
+
+void ArchiveLoader::updatePrefetch() {
+	if (_prefetchQueue.empty()) {
+		return;
+	}
+
+	PrefetchedArchive &current = _prefetchQueue.front();
+	if (!_prefetchFile.isOpen()) {
+		if (!_prefetchFile.open(current.filename)
+				|| _prefetchFile.size() == 0 || _prefetchFile.size() > kMaxPreloadSize) {
+			_prefetchFile.close();
+			_prefetchQueue.pop_front();
+			return;
+		}
+
+		current.size = _prefetchFile.size();
+		current.data = Common::SharedPtr<byte>(new byte[current.size], Common::ArrayDeleter<byte>());
+		_prefetchPosition = 0;
+	}
+
+	uint32 chunkSize = MIN(kPrefetchChunkSize, current.size - _prefetchPosition);
+	if (_prefetchFile.read(current.data.get() + _prefetchPosition, chunkSize) != chunkSize) {
+		_prefetchFile.close();
+		_prefetchQueue.pop_front();
+		return;
+	}
+
+	_prefetchPosition += chunkSize;
+	if (_prefetchPosition == current.size) {
+		_prefetchFile.close();
+		_prefetched.push_back(current);
+		_prefetchQueue.pop_front();
+
+		while (_prefetched.size() > kMaxPrefetchedArchives) {
+			_prefetched.pop_front();
+		}
+	}
+}
+
+bool ArchiveLoader::takePrefetched(const Common::Path &archiveName, PrefetchedArchive &prefetched) {
+	// An archive still being read is not worth waiting for
+	for (PrefetchedArchiveList::iterator it = _prefetchQueue.begin(); it != _prefetchQueue.end(); it++) {
+		if (it->filename == archiveName) {
+			if (it == _prefetchQueue.begin()) {
+				_prefetchFile.close();
+			}
+			_prefetchQueue.erase(it);
+			break;
+		}
+	}
+
+	for (PrefetchedArchiveList::iterator it = _prefetched.begin(); it != _prefetched.end(); it++) {
+		if (it->filename == archiveName) {
+			prefetched = *it;
+			_prefetched.erase(it);
+			return true;
+		}
+	}
+
+	return false;
+}
+
 Common::Path ArchiveLoader::getExternalFilePath(const Common::Path &fileName, const Common::Path &archiveName) const {
 	// Build a path of the type 45/00/
 	Common::Path filePath = archiveName;
@@ -22,6 +22,7 @@
 #ifndef STARK_SERVICES_ARCHIVE_LOADER_H
 #define STARK_SERVICES_ARCHIVE_LOADER_H
 
+#include "common/file.h"
 #include "common/list.h"
 #include "common/str.h"
 #include "common/substream.h"
@@ -64,6 +65,7 @@ public:
 class ArchiveLoader {
 
 public:
+	ArchiveLoader();
 	~ArchiveLoader();
 
 	/** Load a Xarc archive, and add it to the managed archives list */
@@ -84,6 +86,16 @@ public:
 
 	/** Build the archive filename for a level or a location */
 	Common::Path buildArchiveName(Resources::Level *level, Resources::Location *location = nullptr) const;
+	Common::Path buildLocationArchiveName(uint16 levelIndex, uint16 locationIndex) const;
+
+	/** Queue an archive to be read ahead of time, before it is loaded */
+	void prefetch(const Common::Path &archiveName);
+
+	/** Drop the archives queued or read ahead of time */
+	void clearPrefetch();
+
+	/** Read the next chunk of the archives queued for prefetching */
+	void updatePrefetch();
 
 	/** Retrieve a file relative to a specified archive */
 	Common::SeekableReadStream *getExternalFile(const Common::Path &fileName, const Common::Path &archiveName) const;
@@ -97,6 +109,7 @@ private:
 
 		const Common::Path &getFilename() const { return _filename; }
 		const Formats::XARCArchive &getXArc() const { return _xarc; }
+		Formats::XARCArchive &getXArc() { return _xarc; }
 		Resources::Object *getRoot() const { return _root; }
 
 		void importResources();
@@ -114,10 +127,24 @@ private:
 
 	typedef Common::List<LoadedArchive *> LoadedArchiveList;
 
+	struct PrefetchedArchive {
+		Common::Path filename;
+		Common::SharedPtr<byte> data;
+		uint32 size;
+	};
+
+	typedef Common::List<PrefetchedArchive> PrefetchedArchiveList;
+
 	bool hasArchive(const Common::Path &archiveName) const;
 	LoadedArchive *findArchive(const Common::Path &archiveName) const;
+	bool takePrefetched(const Common::Path &archiveName, PrefetchedArchive &prefetched);
 
 	LoadedArchiveList _archives;
+
+	PrefetchedArchiveList _prefetchQueue;
+	PrefetchedArchiveList _prefetched;
+	Common::File _prefetchFile;
+	uint32 _prefetchPosition;
 };
 
 template <class T>
@@ -23,6 +23,7 @@
 
 #include "engines/stark/resources/bookmark.h"
 #include "engines/stark/resources/camera.h"
+#include "engines/stark/resources/command.h"
 #include "engines/stark/resources/floor.h"
 #include "engines/stark/resources/item.h"
 #include "engines/stark/resources/knowledgeset.h"
@@ -254,10 +255,39 @@ void ResourceProvider::performLocationChange() {
 
 	current->getLocation()->resetAnimationBlending();
 	purgeOldLocations();
+	prefetchReachableLocations();
 
 	_locationChangeRequest = false;
 }
 
+void ResourceProvider::prefetchReachableLocations() {
+	_archiveLoader->clearPrefetch();
+
+	// The location change commands of the current location lead to the locations that may come next
+	Resources::Location *location = _global->getCurrent()->getLocation();
+	Common::Array<Resources::Command *> commands = location->listChildrenRecursive<Resources::Command>(Resources::Command::kLocationGoTo);
+	commands.push_back(location->listChildrenRecursive<Resources::Command>(Resources::Command::kLocationGoToNewCD));
+
+	Resources::Root *root = _global->getRoot();
+	for (uint i = 0; i < commands.size(); i++) {
+		Common::Array<Resources::Command::Argument> arguments = commands[i]->getArguments();
+		if (arguments.size() < 2) {
+			continue;
+		}
+
+		uint levelIndex = strtol(arguments[0].stringValue.c_str(), nullptr, 16);
+		uint locationIndex = strtol(arguments[1].stringValue.c_str(), nullptr, 16);
+
+		Resources::Level *level = root->findChildWithIndex<Resources::Level>(levelIndex);
+		if (!level) {
+			continue;
+		}
+
+		_archiveLoader->prefetch(_archiveLoader->buildArchiveName(level));
+		_archiveLoader->prefetch(_archiveLoader->buildLocationArchiveName(levelIndex, locationIndex));
+	}
+}
+
 void ResourceProvider::runLocationChangeScripts(Resources::Object *resource, uint32 scriptCallMode) {
 	Common::Array<Resources::Script *> scripts = resource->listChildrenRecursive<Resources::Script>();
 
@@ -364,6 +394,7 @@ void ResourceProvider::shutdown() {
 		delete location;
 	}
 	_locations.clear();
+	_archiveLoader->clearPrefetch();
 
 	// Return the global resources
 	if (_global->getLevel()) {
@@ -111,6 +111,7 @@ private:
 	Current *findLocation(uint16 level, uint16 location) const;
 
 	void purgeOldLocations();
+	void prefetchReachableLocations();
 
 	void runLocationChangeScripts(Resources::Object *resource, uint32 scriptCallMode);
 	void setAprilInitialPosition();
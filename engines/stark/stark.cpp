@@ -168,6 +168,8 @@ void StarkEngine::mainLoop() {
 			StarkResourceProvider->performLocationChange();
 		}
 
+		StarkArchiveLoader->updatePrefetch();
+
 		StarkUserInterface->doQueuedScreenChange();
 
 		updateDisplayScene();
@@ -384,6 +384,7 @@ bool Application::run() {
 		Game *game = g_engine->getGame();
 
 		renderer->reset();
+		g_engine->getResourceManager()->update();
 		game->update();
 		game->scene().updateScroll();
 		g_engine->getSoundManager()->update();
@@ -40,6 +40,7 @@
 #include "tetraedge/te/te_core.h"
 #include "tetraedge/te/te_input_mgr.h"
 #include "tetraedge/te/te_ray_intersection.h"
+#include "tetraedge/te/te_resource_manager.h"
 #include "tetraedge/te/te_sound_manager.h"
 #include "tetraedge/te/te_variant.h"
 #include "tetraedge/te/te_lua_thread.h"
@@ -206,6 +207,9 @@ bool SyberiaGame::changeWarp(const Common::String &zone, const Common::String &s
 	_warpScene = scene;
 	_warpFadeFlag = fadeFlag;
 	_warped = true;
+
+	// Decode the images of the next scene while the fade is playing
+	preloadSceneImages(zone, scene);
 	return true;
 }
 
@@ -249,7 +253,66 @@ bool SyberiaGame::changeWarp2(const Common::String &zone, const Common::String &
 	if (!fadeFlag)
 		g_engine->getApplication()->fade();
 
-	return initWarp(zone, scene, false);
+	bool result = initWarp(zone, scene, false);
+
+	// Images the scene did not use yet are not worth keeping around
+	g_engine->getResourceManager()->releaseCodecs();
+	return result;
+}
+
+static bool isImagePathChar(byte c) {
+	return Common::isAlnum(c) || c == '/' || c == '_' || c == '-' || c == '.';
+}
+
+void SyberiaGame::preloadSceneImages(const Common::String &zone, const Common::String &scene) {
+	static const char *const scriptPrefixes[] = { "Set", "For", "Int", "Marker" };
+	static const char *const imageExtensions[] = { ".png", ".jpg", ".tga" };
+
+	TeCore *core = g_engine->getCore();
+	TeResourceManager *resmgr = g_engine->getResourceManager();
+	resmgr->releaseCodecs();
+
+	Common::Path scenePath("scenes");
+	scenePath.joinInPlace(zone);
+	scenePath.joinInPlace(scene);
+
+	// The GUI scripts of a scene are its manifest: the images of its sprites
+	// appear as plain strings in them, whether they are compiled or not.
+	for (const char *prefix : scriptPrefixes) {
+		const TetraedgeFSNode node = core->findFile(scenePath.join(Common::String::format("%s%s.lua", prefix, scene.c_str())));
+		Common::ScopedPtr<Common::SeekableReadStream> stream(node.createReadStream());
+		if (!stream)
+			continue;
+
+		const uint32 size = stream->size();
+		Common::Array<byte> script(size);
+		if (stream->read(script.data(), size) != size)
+			continue;
+
+		for (uint32 end = 0; end < size; end++) {
+			for (const char *extension : imageExtensions) {
+				const uint32 extLen = strlen(extension);
+				if (end + extLen > size || memcmp(&script[end], extension, extLen) != 0)
+					continue;
+				if (end + extLen < size && isImagePathChar(script[end + extLen]))
+					continue;
+
+				uint32 start = end;
+				while (start > 0 && isImagePathChar(script[start - 1]))
+					start--;
+
+				Common::String imgPath((const char *)&script[start], end + extLen - start);
+				// Same fix-up as spriteLayoutBindings
+				uint32 loc = imgPath.find("//");
+				if (loc != Common::String::npos)
+					imgPath.replace(loc, 2, "/");
+				if (imgPath.hasPrefix("./") || imgPath.size() == extLen)
+					continue;
+
+				resmgr->requestCodec(Common::Path(imgPath));
+			}
+		}
+	}
 }
 
 void SyberiaGame::deleteNoScale() {
@@ -1394,6 +1457,10 @@ void SyberiaGame::update() {
 		_objectif.update();
 		_scene.update();
 	} else {
+		// Let the fade play until the images of the next scene are decoded
+		if (g_engine->getResourceManager()->hasPendingRequests())
+			return;
+
 		TeSoundManager *soundmgr = g_engine->getSoundManager();
 		// Take a copy in case the active music objects changes as we iterate.
 		Common::Array<TeMusic *> musics = soundmgr->musics();
@@ -139,6 +139,7 @@ private:
 
 	void initNoScale();
 	void initScene(bool param_1, const Common::String &scenePath);
+	void preloadSceneImages(const Common::String &zone, const Common::String &scene);
 	bool initWarp(const Common::String &zone, const Common::String &scene, bool fadeFlag);
 
 	bool onCallNumber(Common::String val);
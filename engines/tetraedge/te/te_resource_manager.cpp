@@ -19,15 +19,26 @@
  *
  */
 
+#include "common/system.h"
+
 #include "tetraedge/te/te_resource.h"
 #include "tetraedge/te/te_resource_manager.h"
+#include "tetraedge/te/te_i_codec.h"
+#include "tetraedge/te/te_images_sequence.h"
+#include "tetraedge/te/te_theora.h"
 
 namespace Tetraedge {
 
+// Time spent serving requests each frame.  At least one request is
+// always served, even if it takes longer than this.
+static const uint32 kRequestBudgetMillis = 8;
+
 TeResourceManager::TeResourceManager() {
 }
 
 TeResourceManager::~TeResourceManager() {
+	releaseCodecs();
+
 	// Remove resources one at a time as they may be inter-dependant,
 	// causing removals during iteration.
 	while (_resources.size()) {
@@ -79,4 +90,83 @@ void TeResourceManager::removeResource(const TeResource *resource) {
 	// removeResource request but now it's not in the list any more.
 }
 
+void TeResourceManager::requestCodec(const Common::Path &path, const TeICallback1ParamPtr<const Common::Path &> &callback) {
+	CodecRequest request;
+	request._path = path;
+	request._callback = callback;
+	_codecRequests.push_back(request);
+}
+
+TeICodec *TeResourceManager::takeCodec(const Common::Path &path) {
+	for (uint i = 0; i < _loadedCodecs.size(); i++) {
+		if (_loadedCodecs[i]._path == path) {
+			TeICodec *codec = _loadedCodecs[i]._codec;
+			_loadedCodecs.remove_at(i);
+			return codec;
+		}
+	}
+	return nullptr;
+}
+
+void TeResourceManager::releaseCodecs() {
+	_codecRequests.clear();
+	for (auto &loaded : _loadedCodecs)
+		delete loaded._codec;
+	_loadedCodecs.clear();
+}
+
+void TeResourceManager::loadCodec(const Common::Path &path) {
+	// Nothing to do if the texture is already around or the image was already decoded
+	if (exists(path.append(".tt")))
+		return;
+	for (const auto &loaded : _loadedCodecs) {
+		if (loaded._path == path)
+			return;
+	}
+
+	const Common::String filename = path.baseName();
+	if (!filename.contains('.'))
+		return;
+	Common::String extn = filename.substr(filename.findLastOf('.') + 1);
+	extn.toLowercase();
+
+	// Videos and image sequences are decoded as they play
+	if (TeTheora::matchExtension(extn) || TeImagesSequence::matchExtension(extn))
+		return;
+
+	TeCore *core = g_engine->getCore();
+	const TetraedgeFSNode node = core->findFile(path);
+	if (!node.isReadable())
+		return;
+
+	TeICodec *codec = core->createVideoCodec(extn);
+	if (!codec)
+		return;
+
+	if (!codec->load(node)) {
+		delete codec;
+		return;
+	}
+
+	LoadedCodec loaded;
+	loaded._path = path;
+	loaded._codec = codec;
+	_loadedCodecs.push_back(loaded);
+}
+
+void TeResourceManager::update() {
+	const uint32 start = g_system->getMillis();
+	while (!_codecRequests.empty()) {
+		CodecRequest request = _codecRequests.front();
+		_codecRequests.pop_front();
+
+		loadCodec(request._path);
+		if (request._callback)
+			request._callback->call(request._path);
+
+		if (g_system->getMillis() - start >= kRequestBudgetMillis)
+			break;
+	}
+}
+
 } // end namespace Tetraedge
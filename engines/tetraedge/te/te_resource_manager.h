@@ -23,6 +23,7 @@
 #define TETRAEDGE_TE_TE_RESOURCE_MANAGER_H
 
 #include "common/array.h"
+#include "common/list.h"
 #include "common/path.h"
 #include "common/ptr.h"
 #include "common/file.h"
@@ -32,9 +33,11 @@
 #include "tetraedge/te/te_resource.h"
 #include "tetraedge/te/te_core.h"
 #include "tetraedge/te/te_intrusive_ptr.h"
+#include "tetraedge/te/te_signal.h"
 
 namespace Tetraedge {
 
+class TeICodec;
 class TeResource;
 
 class TeResourceManager {
@@ -79,8 +82,38 @@ public:
 		return retval;
 	}
 
+	/**
+	 * Queue the decoding of a still image so that it is ready by the time a
+	 * surface loads it.  Requests are served by update() between frames, and
+	 * the callback, if any, is called with the path once it has been served.
+	 */
+	void requestCodec(const Common::Path &path, const TeICallback1ParamPtr<const Common::Path &> &callback = TeICallback1ParamPtr<const Common::Path &>());
+	bool hasPendingRequests() const { return !_codecRequests.empty(); }
+
+	/** Take ownership of an image decoded by requestCodec, or return nullptr. */
+	TeICodec *takeCodec(const Common::Path &path);
+
+	/** Drop pending requests and the decoded images nobody took. */
+	void releaseCodecs();
+
+	void update();
+
 private:
+	struct CodecRequest {
+		Common::Path _path;
+		TeICallback1ParamPtr<const Common::Path &> _callback;
+	};
+
+	struct LoadedCodec {
+		Common::Path _path;
+		TeICodec *_codec;
+	};
+
+	void loadCodec(const Common::Path &path);
+
 	Common::Array<TeIntrusivePtr<TeResource>> _resources;
+	Common::List<CodecRequest> _codecRequests;
+	Common::Array<LoadedCodec> _loadedCodecs;
 
 };
 
@@ -75,14 +75,20 @@ bool TeTiledSurface::load(const TetraedgeFSNode &node) {
 	}
 
 	if (!texture) {
-		TeCore *core = g_engine->getCore();
-		_codec = core->createVideoCodec(node, _loadedPath);
-		if (!_codec)
-			return false;
+		// The image may have been decoded ahead of time, see TeResourceManager::requestCodec
+		_codec = resmgr->takeCodec(_loadedPath);
+		bool loaded = (_codec != nullptr);
+		if (!_codec) {
+			TeCore *core = g_engine->getCore();
+			_codec = core->createVideoCodec(node, _loadedPath);
+			if (!_codec)
+				return false;
+			loaded = _codec->load(node);
+		}
 
 		texture = new TeTiledTexture();
 
-		if (_codec->load(node)) {
+		if (loaded) {
 			texture->setAccessName(ttPath);
 			resmgr->addResource(texture.get());
 			_imgFormat = _codec->imageFormat();
@@ -21,6 +21,7 @@
 
 #include "common/archive.h"
 #include "common/debug.h"
+#include "common/system.h"
 #include "twp/detection.h"
 #include "twp/ggpack.h"
 
@@ -578,28 +579,43 @@ bool RangeStream::seek(int64 offset, int whence) {
 	return _s->seek(offset, whence);
 }
 
+void xorDecodeGeneric(byte *buf, uint32 start, uint32 size, int pos, const byte *magic, int multiplier, byte &previous) {
+	byte prev = previous;
+	for (uint32 i = start; i < size; i++) {
+		const byte x = buf[i] ^ magic[(pos + i) & 0x0F] ^ (byte)(i * multiplier);
+		buf[i] = x ^ prev;
+		prev = x;
+	}
+	previous = prev;
+}
+
 XorStream::XorStream() : _s(nullptr), _size(0) {
+	memset(_magic, 0, sizeof(_magic));
 }
 
 bool XorStream::open(Common::SeekableReadStream *stream, int len, const XorKey &key) {
 	_s = stream;
 	_start = _s->pos();
-	_previous = (len & 0xFF);
-	_key = key;
+	_previous = (byte)(len & 0xFF);
+	for (uint i = 0; i < 16; i++) {
+		_magic[i] = (byte)key.magicBytes[i];
+	}
+	_multiplier = key.multiplier;
 	_size = len;
+
+	_decode = xorDecodeGeneric;
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+		_decode = xorDecodeSSE2;
+	}
+#endif
 	return true;
 }
 
 uint32 XorStream::read(void *dataPtr, uint32 dataSize) {
 	int p = (int)pos();
 	uint32 result = _s->read(dataPtr, dataSize);
-	char *buf = (char *)dataPtr;
-	for (size_t i = 0; i < dataSize; i++) {
-		int x = buf[i] ^ _key.magicBytes[p & 0x0F] ^ (i * _key.multiplier);
-		buf[i] = (char)(x ^ _previous);
-		_previous = x;
-		p++;
-	}
+	_decode((byte *)dataPtr, 0, dataSize, p, _magic, _multiplier, _previous);
 	return result;
 }
 
@@ -662,35 +678,44 @@ bool GGPackDecoder::open(Common::SeekableReadStream *s, const XorKey &key) {
 	return true;
 }
 
-GGPackEntryReader::GGPackEntryReader() {}
-
-bool GGPackEntryReader::open(GGPackDecoder &pack, const Common::String &entry) {
-	if (!pack._entries.contains(entry))
+bool GGPackDecoder::decodeEntry(const Common::String &entry, Common::Array<byte> &buf) {
+	GGPackEntries::const_iterator it = _entries.find(entry);
+	if (it == _entries.end())
 		return false;
-	GGPackEntry e = pack._entries[entry];
-	pack._s->seek(e.offset);
+	const GGPackEntry &e = it->_value;
+	_s->seek(e.offset);
 
 	RangeStream rs;
-	if (!rs.open(pack._s, e.size))
+	if (!rs.open(_s, e.size))
 		return false;
 
 	XorStream xs;
-	if (!xs.open(&rs, e.size, pack._key))
+	if (!xs.open(&rs, e.size, _key))
 		return false;
 
-	_buf.resize(e.size);
-	xs.read(_buf.data(), e.size);
+	buf.resize(e.size);
+	xs.read(buf.data(), e.size);
+	return true;
+}
+
+GGPackEntryReader::GGPackEntryReader() {}
+
+bool GGPackEntryReader::open(GGPackDecoder &pack, const Common::String &entry) {
+	GGPackBuffer buf(new Common::Array<byte>());
+	if (!pack.decodeEntry(entry, *buf))
+		return false;
 
-	return _ms.open(_buf.data(), e.size);
+	_buf = buf;
+	return _ms.open(_buf->data(), _buf->size());
 }
 
 bool GGPackEntryReader::open(GGPackSet &packs, const Common::String &entry) {
-	for (auto it = packs._packs.begin(); it != packs._packs.end(); it++) {
-		GGPackDecoder *pack = &it->second;
-		if (open(*pack, entry))
-			return true;
-	}
-	return false;
+	GGPackBuffer buf = packs.getEntry(entry);
+	if (!buf)
+		return false;
+
+	_buf = buf;
+	return _ms.open(_buf->data(), _buf->size());
 }
 
 uint32 GGPackEntryReader::read(void *dataPtr, uint32 dataSize) {
@@ -738,6 +763,9 @@ bool GGPackSet::containsDLC() const {
 }
 
 void GGPackSet::init(const XorKey &key) {
+	// Entries decoded from the previously opened packs may be outdated
+	clearCache();
+
 	Common::ArchiveMemberList fileList;
 	SearchMan.listMatchingMembers(fileList, "*.ggpack*");
 
@@ -764,6 +792,54 @@ void GGPackSet::init(const XorKey &key) {
 	error("This version of the game is invalid or not supported (yet?)");
 }
 
+GGPackBuffer GGPackSet::getEntry(const Common::String &entry) {
+	GGPackBuffer buf = _cache.getValOrDefault(entry);
+	if (buf) {
+		for (Common::List<Common::String>::iterator it = _cacheOrder.begin(); it != _cacheOrder.end(); ++it) {
+			if (*it == entry) {
+				_cacheOrder.erase(it);
+				break;
+			}
+		}
+		_cacheOrder.push_front(entry);
+		return buf;
+	}
+
+	buf.reset(new Common::Array<byte>());
+	for (auto it = _packs.begin(); it != _packs.end(); it++) {
+		if (it->second.decodeEntry(entry, *buf)) {
+			addToCache(entry, buf);
+			return buf;
+		}
+	}
+	return GGPackBuffer();
+}
+
+void GGPackSet::addToCache(const Common::String &entry, const GGPackBuffer &buffer) {
+	// big entries (music, videos) would flush everything else
+	const uint32 size = buffer->size();
+	if (size > kCacheBudget / 8)
+		return;
+
+	while (!_cacheOrder.empty() && _cacheSize + size > kCacheBudget) {
+		const Common::String &oldest = _cacheOrder.back();
+		_cacheSize -= _cache[oldest]->size();
+		_cache.erase(oldest);
+		_cacheOrder.pop_back();
+	}
+
+	_cache[entry] = buffer;
+	_cacheOrder.push_front(entry);
+	_cacheSize += size;
+	debugC(kDebugGGPack, "cached %s (%u bytes, %u in cache)", entry.c_str(), size, _cacheSize);
+}
+
+void GGPackSet::clearCache() {
+	_cache.clear();
+	_cacheOrder.clear();
+	_cacheSize = 0;
+}
+
 bool GGPackSet::assetExists(const char *asset) {
 	for (size_t i = 0; i < _packs.size(); i++) {
 		GGPackDecoder *pack = &_packs[i];
@@ -26,6 +26,7 @@
 #include "common/stream.h"
 #include "common/list.h"
 #include "common/path.h"
+#include "common/ptr.h"
 #include "common/stablemap.h"
 #include "common/formats/json.h"
 
@@ -39,6 +40,16 @@ struct XorKey {
 	int multiplier = 0;
 };
 
+// Decodes buf[start..size) in place. The index i of a byte inside buf is
+// mixed with the multiplier and (pos + i) selects the magic byte; previous
+// carries the last undecoded byte between calls.
+typedef void (*XorDecoder)(byte *buf, uint32 start, uint32 size, int pos, const byte *magic, int multiplier, byte &previous);
+
+void xorDecodeGeneric(byte *buf, uint32 start, uint32 size, int pos, const byte *magic, int multiplier, byte &previous);
+#ifdef SCUMMVM_SSE2
+void xorDecodeSSE2(byte *buf, uint32 start, uint32 size, int pos, const byte *magic, int multiplier, byte &previous);
+#endif
+
 class MemStream : public Common::SeekableReadStream {
 public:
 	MemStream();
@@ -88,10 +99,12 @@ public:
 
 private:
 	Common::SeekableReadStream *_s = nullptr;
-	int _previous = 0;
+	byte _previous = 0;
 	int _start = 0;
 	int _size = 0;
-	XorKey _key;
+	byte _magic[16];
+	int _multiplier = 0;
+	XorDecoder _decode = nullptr;
 };
 
 class RangeStream : public Common::SeekableReadStream {
@@ -171,12 +184,17 @@ public:
 
 	bool assetExists(const char *asset) { return _entries.contains(asset); }
 
+	// Decodes the whole entry into buf
+	bool decodeEntry(const Common::String &entry, Common::Array<byte> &buf);
+
 private:
 	XorKey _key;
 	GGPackEntries _entries;
 	Common::SeekableReadStream *_s = nullptr;
 };
 
+typedef Common::SharedPtr<Common::Array<byte> > GGPackBuffer;
+
 class GGPackSet {
 public:
 	void init(const XorKey &key);
@@ -184,8 +202,24 @@ public:
 
 	bool containsDLC() const;
 
+	// Returns the decoded entry from the first pack containing it.
+	// Recently used entries are kept decoded up to kCacheBudget bytes,
+	// so reopening scripts, sheets or sounds is only a lookup.
+	GGPackBuffer getEntry(const Common::String &entry);
+	void clearCache();
+
+private:
+	void addToCache(const Common::String &entry, const GGPackBuffer &buffer);
+
 public:
 	Common::StableMap<long, GGPackDecoder, Common::Greater<long> > _packs;
+
+private:
+	static const uint32 kCacheBudget = 32 * 1024 * 1024;
+
+	Common::HashMap<Common::String, GGPackBuffer, Common::IgnoreCase_Hash> _cache;
+	Common::List<Common::String> _cacheOrder; // most recently used first
+	uint32 _cacheSize = 0;
 };
 
 class GGBnutReader : public Common::ReadStream {
@@ -217,7 +251,7 @@ public:
 	bool seek(int64 offset, int whence = SEEK_SET) override;
 
 private:
-	Common::Array<byte> _buf;
+	GGPackBuffer _buf;
 	MemStream _ms;
 };
 
@@ -0,0 +1,79 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "twp/ggpack.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Twp {
+
+void xorDecodeSSE2(byte *buf, uint32 start, uint32 size, int pos, const byte *magic, int multiplier, byte &previous) {
+	// magic bytes lined up with the first byte of each 16 bytes block
+	byte rotated[16];
+	// low bytes of (start + k) * multiplier, the whole block gains 16 * multiplier each step
+	byte products[16];
+	for (uint32 k = 0; k < 16; k++) {
+		rotated[k] = magic[(pos + start + k) & 0x0F];
+		products[k] = (byte)((start + k) * multiplier);
+	}
+	const __m128i magic16 = _mm_loadu_si128((const __m128i *)rotated);
+	const __m128i step = _mm_set1_epi8((char)(16 * multiplier));
+	__m128i product = _mm_loadu_si128((const __m128i *)products);
+
+	uint32 i = start;
+	byte prev = previous;
+	for (; i + 16 <= size; i += 16) {
+		const __m128i x = _mm_xor_si128(_mm_xor_si128(_mm_loadu_si128((const __m128i *)(buf + i)), magic16), product);
+		// each output byte is x ^ the x before it, the first one uses the carried byte
+		const __m128i before = _mm_or_si128(_mm_slli_si128(x, 1), _mm_cvtsi32_si128(prev));
+		_mm_storeu_si128((__m128i *)(buf + i), _mm_xor_si128(x, before));
+		prev = (byte)(_mm_extract_epi16(x, 7) >> 8);
+		product = _mm_add_epi8(product, step);
+	}
+	previous = prev;
+
+	xorDecodeGeneric(buf, i, size, pos, magic, multiplier, previous);
+}
+
+} // End of namespace Twp
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
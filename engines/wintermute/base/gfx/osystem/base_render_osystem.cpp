@@ -41,6 +41,10 @@
 
 #define DIRTY_RECT_LIMIT 800
 
+// Maximum number of separate dirty rects tracked per frame. Beyond this,
+// new rects are merged into whichever existing one grows the least.
+#define MAX_DIRTY_RECTS 16
+
 namespace Wintermute {
 
 BaseRenderer *makeOSystemRenderer(BaseGame *inGame) {
@@ -56,7 +60,8 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 	_borderLeft = _borderRight = _borderTop = _borderBottom = 0;
 	_ratioX = _ratioY = 1.0f;
-	_dirtyRect = nullptr;
+	_lastFramePixelsRedrawn = 0;
+	_lastFrameDirtyRects = 0;
 	_disableDirtyRects = false;
 	if (ConfMan.hasKey("dirty_rects")) {
 		_disableDirtyRects = !ConfMan.getBool("dirty_rects");
@@ -74,8 +79,6 @@ BaseRenderOSystem::~BaseRenderOSystem() {
 		delete ticket;
 	}
 
-	delete _dirtyRect;
-
 	_renderSurface->free();
 	delete _renderSurface;
 }
@@ -148,8 +151,7 @@ bool BaseRenderOSystem::forcedFlip() {
 bool BaseRenderOSystem::flip() {
 	if (_skipThisFrame) {
 		_skipThisFrame = false;
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		g_system->updateScreen();
 		_needsFlip = false;
 
@@ -188,8 +190,7 @@ bool BaseRenderOSystem::flip() {
 		if (_disableDirtyRects || screenChanged) {
 			g_system->copyRectToScreen(_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
 		}
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		_needsFlip = false;
 	}
 	_lastFrameIter = _renderQueue.end();
@@ -350,12 +351,48 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 }
 
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
-	if (!_dirtyRect) {
-		_dirtyRect = new Common::Rect(rect);
-	} else {
-		_dirtyRect->extend(rect);
+	Common::Rect newRect(rect);
+	newRect.clip(_renderRect);
+	if (newRect.isEmpty()) {
+		return;
 	}
-	_dirtyRect->clip(_renderRect);
+
+	// Absorb every rect overlapping the new one. Extending the new rect may
+	// make it overlap rects that were checked before, so start over then.
+	bool merged;
+	do {
+		merged = false;
+		for (uint i = 0; i < _dirtyRects.size(); i++) {
+			if (_dirtyRects[i].intersects(newRect)) {
+				newRect.extend(_dirtyRects[i]);
+				_dirtyRects.remove_at(i);
+				merged = true;
+				break;
+			}
+		}
+	} while (merged);
+
+	if (_dirtyRects.size() < MAX_DIRTY_RECTS) {
+		_dirtyRects.push_back(newRect);
+		return;
+	}
+
+	// Out of slots: merge into the rect which grows the least, then re-add
+	// the result so that it absorbs whatever it now overlaps.
+	uint best = 0;
+	int bestGrowth = 0;
+	for (uint i = 0; i < _dirtyRects.size(); i++) {
+		Common::Rect bounds(_dirtyRects[i]);
+		bounds.extend(newRect);
+		int growth = bounds.width() * bounds.height() - _dirtyRects[i].width() * _dirtyRects[i].height();
+		if (i == 0 || growth < bestGrowth) {
+			best = i;
+			bestGrowth = growth;
+		}
+	}
+	newRect.extend(_dirtyRects[best]);
+	_dirtyRects.remove_at(best);
+	addDirtyRect(newRect);
 }
 
 void BaseRenderOSystem::drawTickets() {
@@ -374,7 +411,9 @@ void BaseRenderOSystem::drawTickets() {
 			++it;
 		}
 	}
-	if (!_dirtyRect || _dirtyRect->width() == 0 || _dirtyRect->height() == 0) {
+	_lastFramePixelsRedrawn = 0;
+	_lastFrameDirtyRects = _dirtyRects.size();
+	if (_dirtyRects.empty()) {
 		it = _renderQueue.begin();
 		while (it != _renderQueue.end()) {
 			RenderTicket *ticket = *it;
@@ -391,36 +430,47 @@ void BaseRenderOSystem::drawTickets() {
 	// Caveat: The FPS-counter will invalidate this.
 	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
 		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
-			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+		if (_dirtyRects.size() != 1 || _dirtyRects[0] != (*it)->_dstRect) {
+			// Apply the clear-color to the dirty rects.
+			for (uint i = 0; i < _dirtyRects.size(); i++) {
+				_renderSurface->fillRect(_dirtyRects[i], _clearColor);
+			}
 		}
 		// Otherwise Do NOT fill.
 	} else {
-		// Apply the clear-color to the dirty rect.
-		_renderSurface->fillRect(*_dirtyRect, _clearColor);
+		// Apply the clear-color to the dirty rects.
+		for (uint i = 0; i < _dirtyRects.size(); i++) {
+			_renderSurface->fillRect(_dirtyRects[i], _clearColor);
+		}
 	}
 	for (; it != _renderQueue.end(); ++it) {
 		RenderTicket *ticket = *it;
-		if (ticket->_dstRect.intersects(*_dirtyRect)) {
-			// dstClip is the area we want redrawn.
-			Common::Rect dstClip(ticket->_dstRect);
-			// reduce it to the dirty rect
-			dstClip.clip(*_dirtyRect);
-			// we need to keep track of the position to redraw the dirty rect
-			Common::Rect pos(dstClip);
-			int16 offsetX = ticket->_dstRect.left;
-			int16 offsetY = ticket->_dstRect.top;
-			// convert from screen-coords to surface-coords.
-			dstClip.translate(-offsetX, -offsetY);
-
-			drawFromSurface(ticket, &pos, &dstClip);
-			_needsFlip = true;
+		// The dirty rects never overlap, so each part of the ticket is drawn once.
+		for (uint i = 0; i < _dirtyRects.size(); i++) {
+			if (ticket->_dstRect.intersects(_dirtyRects[i])) {
+				// dstClip is the area we want redrawn.
+				Common::Rect dstClip(ticket->_dstRect);
+				// reduce it to the dirty rect
+				dstClip.clip(_dirtyRects[i]);
+				// we need to keep track of the position to redraw the dirty rect
+				Common::Rect pos(dstClip);
+				int16 offsetX = ticket->_dstRect.left;
+				int16 offsetY = ticket->_dstRect.top;
+				// convert from screen-coords to surface-coords.
+				dstClip.translate(-offsetX, -offsetY);
+
+				drawFromSurface(ticket, &pos, &dstClip);
+				_needsFlip = true;
+			}
 		}
 		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldn't become clear-color)
 		ticket->_wantsDraw = false;
 	}
-	g_system->copyRectToScreen(_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
+	for (uint i = 0; i < _dirtyRects.size(); i++) {
+		const Common::Rect &dirtyRect = _dirtyRects[i];
+		g_system->copyRectToScreen(_renderSurface->getBasePtr(dirtyRect.left, dirtyRect.top), _renderSurface->pitch, dirtyRect.left, dirtyRect.top, dirtyRect.width(), dirtyRect.height());
+		_lastFramePixelsRedrawn += dirtyRect.width() * dirtyRect.height();
+	}
 
 	it = _renderQueue.begin();
 	// Clean out the old tickets
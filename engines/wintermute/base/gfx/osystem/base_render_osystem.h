@@ -30,6 +30,7 @@
 
 #include "engines/wintermute/base/gfx/base_renderer.h"
 
+#include "common/array.h"
 #include "common/rect.h"
 #include "common/list.h"
 
@@ -113,9 +114,17 @@ public:
 	void endSaveLoad() override;
 	void drawSurface(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform);
 	BaseSurface *createSurface() override;
+
+	/** Number of pixels redrawn by the dirty-rect path during the last frame. */
+	uint32 getLastFramePixelsRedrawn() const { return _lastFramePixelsRedrawn; }
+	/** Number of separate dirty rects redrawn during the last frame. */
+	uint32 getLastFrameDirtyRects() const { return _lastFrameDirtyRects; }
+	bool isDirtyRectsEnabled() const { return !_disableDirtyRects; }
 private:
 	/**
 	 * Mark a specified rect of the screen as dirty.
+	 * The rect is merged with any overlapping dirty rects, so that the
+	 * resulting rects never overlap and no pixel gets drawn twice.
 	 * @param rect the region to be marked as dirty
 	 */
 	void addDirtyRect(const Common::Rect &rect);
@@ -127,7 +136,9 @@ private:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
-	Common::Rect *_dirtyRect;
+	Common::Array<Common::Rect> _dirtyRects;
+	uint32 _lastFramePixelsRedrawn;
+	uint32 _lastFrameDirtyRects;
 	Common::List<RenderTicket *> _renderQueue;
 
 	bool _needsFlip;
@@ -79,6 +79,7 @@ public:
 	TScriptState _state;
 	TScriptState _origState;
 	ScValue *getVar(char *name);
+	ScValue *getVarByAtom(const char *name, uint32 atom);
 	uint32 getFuncPos(const Common::String &name);
 	uint32 getEventPos(const Common::String &name) const;
 	uint32 getMethodPos(const Common::String &name) const;
@@ -151,6 +152,7 @@ public:
 	bool externalCall(ScStack *stack, ScStack *thisStack, ScScript::TExternalFunction *function);
 private:
 	char **_symbols;
+	uint32 *_symbolAtoms; // ScAtomTable atom of each entry of _symbols
 	uint32 _numSymbols;
 	TFunctionPos *_functions;
 	TMethodPos *_methods;
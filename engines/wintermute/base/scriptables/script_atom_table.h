@@ -0,0 +1,56 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef WINTERMUTE_SCATOMTABLE_H
+#define WINTERMUTE_SCATOMTABLE_H
+
+#include "common/array.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/str.h"
+
+namespace Wintermute {
+
+/**
+ * Interns script property and variable names.
+ * Each distinct name is assigned a small integer id (an "atom"), so that
+ * ScValue can key its properties by integer instead of hashing and
+ * comparing strings on every access. Atoms are never released; the number
+ * of distinct names used by a game is small.
+ */
+class ScAtomTable {
+public:
+	static const uint32 kNoAtom = 0xFFFFFFFF;
+
+	/** Returns the atom for the given name, creating it if needed. */
+	uint32 intern(const char *name);
+	/** Returns the atom for the given name, or kNoAtom if it was never interned. */
+	uint32 find(const char *name) const;
+	const Common::String &getName(uint32 atom) const { return _names[atom]; }
+
+private:
+	Common::HashMap<Common::String, uint32> _atoms;
+	Common::Array<Common::String> _names;
+};
+
+} // End of namespace Wintermute
+
+#endif
@@ -28,6 +28,8 @@
 #include "engines/wintermute/platform_osystem.h"
 #include "engines/wintermute/base/base_dynamic_buffer.h"
 #include "engines/wintermute/base/base_game.h"
+#include "engines/wintermute/base/base_engine.h"
+#include "engines/wintermute/base/scriptables/script_atom_table.h"
 #include "engines/wintermute/base/scriptables/script_value.h"
 #include "engines/wintermute/base/scriptables/script.h"
 #include "engines/wintermute/utils/string_util.h"
@@ -158,8 +160,13 @@ ScValue::~ScValue() {
 
 //////////////////////////////////////////////////////////////////////////
 ScValue *ScValue::getProp(const char *name) {
+	return getPropByAtom(name, BaseEngine::instance().getAtomTable()->find(name));
+}
+
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScValue::getPropByAtom(const char *name, uint32 atom) {
 	if (_type == VAL_VARIABLE_REF) {
-		return _valRef->getProp(name);
+		return _valRef->getPropByAtom(name, atom);
 	}
 
 	if (_type == VAL_STRING && strcmp(name, "Length") == 0) {
@@ -181,8 +188,8 @@ ScValue *ScValue::getProp(const char *name) {
 		ret = _valNative->scGetProperty(name);
 	}
 
-	if (ret == nullptr) {
-		_valIter = _valObject.find(name);
+	if (ret == nullptr && atom != ScAtomTable::kNoAtom) {
+		_valIter = _valObject.find(atom);
 		if (_valIter != _valObject.end()) {
 			ret = _valIter->_value;
 		}
@@ -196,7 +203,12 @@ bool ScValue::deleteProp(const char *name) {
 		return _valRef->deleteProp(name);
 	}
 
-	_valIter = _valObject.find(name);
+	uint32 atom = BaseEngine::instance().getAtomTable()->find(name);
+	if (atom == ScAtomTable::kNoAtom) {
+		return STATUS_OK;
+	}
+
+	_valIter = _valObject.find(atom);
 	if (_valIter != _valObject.end()) {
 		delete _valIter->_value;
 		_valIter->_value = nullptr;
@@ -209,8 +221,13 @@ bool ScValue::deleteProp(const char *name) {
 
 //////////////////////////////////////////////////////////////////////////
 bool ScValue::setProp(const char *name, ScValue *val, bool copyWhole, bool setAsConst) {
+	return setPropByAtom(name, BaseEngine::instance().getAtomTable()->intern(name), val, copyWhole, setAsConst);
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool ScValue::setPropByAtom(const char *name, uint32 atom, ScValue *val, bool copyWhole, bool setAsConst) {
 	if (_type == VAL_VARIABLE_REF) {
-		return _valRef->setProp(name, val);
+		return _valRef->setPropByAtom(name, atom, val);
 	}
 
 	bool ret = STATUS_FAILED;
@@ -221,7 +238,7 @@ bool ScValue::setProp(const char *name, ScValue *val, bool copyWhole, bool setAs
 	if (DID_FAIL(ret)) {
 		ScValue *newVal = nullptr;
 
-		_valIter = _valObject.find(name);
+		_valIter = _valObject.find(atom);
 		if (_valIter != _valObject.end()) {
 			newVal = _valIter->_value;
 		}
@@ -233,7 +250,7 @@ bool ScValue::setProp(const char *name, ScValue *val, bool copyWhole, bool setAs
 
 		newVal->copy(val, copyWhole);
 		newVal->_isConstVar = setAsConst;
-		_valObject[name] = newVal;
+		_valObject[atom] = newVal;
 
 		if (_type != VAL_NATIVE) {
 			_type = VAL_OBJECT;
@@ -260,10 +277,18 @@ bool ScValue::setProp(const char *name, ScValue *val, bool copyWhole, bool setAs
 
 //////////////////////////////////////////////////////////////////////////
 bool ScValue::propExists(const char *name) {
+	return propExistsByAtom(BaseEngine::instance().getAtomTable()->find(name));
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool ScValue::propExistsByAtom(uint32 atom) {
 	if (_type == VAL_VARIABLE_REF) {
-		return _valRef->propExists(name);
+		return _valRef->propExistsByAtom(atom);
+	}
+	if (atom == ScAtomTable::kNoAtom) {
+		return false;
 	}
-	_valIter = _valObject.find(name);
+	_valIter = _valObject.find(atom);
 
 	return (_valIter != _valObject.end());
 }
@@ -794,6 +819,7 @@ bool ScValue::persist(BasePersistenceManager *persistMgr) {
 	persistMgr->transferSint32(TMEMBER(_valInt));
 	persistMgr->transferPtr(TMEMBER_PTR(_valNative));
 
+	ScAtomTable *atoms = BaseEngine::instance().getAtomTable();
 	int32 size;
 	const char *str;
 	if (persistMgr->getIsSaving()) {
@@ -801,7 +827,7 @@ bool ScValue::persist(BasePersistenceManager *persistMgr) {
 		persistMgr->transferSint32("", &size);
 		_valIter = _valObject.begin();
 		while (_valIter != _valObject.end()) {
-			str = _valIter->_key.c_str();
+			str = atoms->getName(_valIter->_key).c_str();
 			persistMgr->transferConstChar("", &str);
 			persistMgr->transferPtr("", &_valIter->_value);
 
@@ -814,7 +840,7 @@ bool ScValue::persist(BasePersistenceManager *persistMgr) {
 			persistMgr->transferConstChar("", &str);
 			persistMgr->transferPtr("", &val);
 
-			_valObject[str] = val;
+			_valObject[atoms->intern(str)] = val;
 			delete[] str;
 		}
 	}
@@ -879,10 +905,11 @@ bool ScValue::persist(BasePersistenceManager *persistMgr) {
 
 //////////////////////////////////////////////////////////////////////////
 bool ScValue::saveAsText(BaseDynamicBuffer *buffer, int indent) {
+	ScAtomTable *atoms = BaseEngine::instance().getAtomTable();
 	_valIter = _valObject.begin();
 	while (_valIter != _valObject.end()) {
 		buffer->putTextIndent(indent, "PROPERTY {\n");
-		buffer->putTextIndent(indent + 2, "NAME=\"%s\"\n", _valIter->_key.c_str());
+		buffer->putTextIndent(indent + 2, "NAME=\"%s\"\n", atoms->getName(_valIter->_key).c_str());
 		buffer->putTextIndent(indent + 2, "VALUE=\"%s\"\n", _valIter->_value->getString());
 		buffer->putTextIndent(indent, "}\n\n");
 
@@ -52,6 +52,8 @@ public:
 	void setValue(ScValue *val);
 	bool _persistent;
 	bool propExists(const char *name);
+	/** Same as propExists(), with the name already interned in the ScAtomTable. */
+	bool propExistsByAtom(uint32 atom);
 	void copy(ScValue *orig, bool copyWhole = false);
 	void setStringVal(const char *val);
 	TValType getType();
@@ -82,6 +84,13 @@ public:
 	bool isObject();
 	bool setProp(const char *name, ScValue *val, bool copyWhole = false, bool setAsConst = false);
 	ScValue *getProp(const char *name);
+	/**
+	 * Same as setProp() and getProp(), for callers which have already looked up
+	 * the atom of the name. The name is still needed for native objects.
+	 * The atom passed to getPropByAtom() may be ScAtomTable::kNoAtom.
+	 */
+	bool setPropByAtom(const char *name, uint32 atom, ScValue *val, bool copyWhole = false, bool setAsConst = false);
+	ScValue *getPropByAtom(const char *name, uint32 atom);
 	BaseScriptable *_valNative;
 	ScValue *_valRef;
 private:
@@ -97,8 +106,9 @@ public:
 	ScValue(BaseGame *inGame, double Val);
 	ScValue(BaseGame *inGame, const char *Val);
 	~ScValue() override;
-	Common::HashMap<Common::String, ScValue *> _valObject;
-	Common::HashMap<Common::String, ScValue *>::iterator _valIter;
+	// Properties, keyed by the atom of their name (see ScAtomTable)
+	Common::HashMap<uint32, ScValue *> _valObject;
+	Common::HashMap<uint32, ScValue *>::iterator _valIter;
 
 	bool setProperty(const char *propName, int32 value);
 	bool setProperty(const char *propName, const char *value);
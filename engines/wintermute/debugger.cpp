@@ -22,6 +22,8 @@
 #include "engines/wintermute/debugger.h"
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_file_manager.h"
+#include "engines/wintermute/base/base_game.h"
+#include "engines/wintermute/base/gfx/osystem/base_render_osystem.h"
 #include "engines/wintermute/base/scriptables/script_value.h"
 #include "engines/wintermute/debugger/debugger_controller.h"
 #include "engines/wintermute/wintermute.h"
@@ -34,6 +36,7 @@ Console::Console(WintermuteEngine *vm) : GUI::Debugger(), _engineRef(vm) {
 	registerCmd("show_fps", WRAP_METHOD(Console, Cmd_ShowFps));
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
+	registerCmd("dirty_rects", WRAP_METHOD(Console, Cmd_DirtyRects));
 	registerCmd("help", WRAP_METHOD(Console, Cmd_Help));
 	// Actual (script) debugger commands
 	registerCmd(STEP_CMD, WRAP_METHOD(Console, Cmd_Step));
@@ -306,6 +309,24 @@ bool Console::Cmd_ShowFps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::Cmd_DirtyRects(int argc, const char **argv) {
+	BaseRenderOSystem *renderer = nullptr;
+	if (_engineRef->_game) {
+		renderer = dynamic_cast<BaseRenderOSystem *>(_engineRef->_game->_renderer);
+	}
+	if (!renderer) {
+		debugPrintf("The game is not using the 2D renderer\n");
+		return true;
+	}
+	if (!renderer->isDirtyRectsEnabled()) {
+		debugPrintf("Dirty rects are disabled\n");
+		return true;
+	}
+
+	debugPrintf("Last frame: %u dirty rects, %u pixels redrawn\n", renderer->getLastFrameDirtyRects(), renderer->getLastFramePixelsRedrawn());
+	return true;
+}
+
 bool Console::Cmd_DumpFile(int argc, const char **argv) {
 	if (argc != 3) {
 		debugPrintf("Usage: %s <file path> <output file name>\n", argv[0]);
@@ -30,6 +30,7 @@ MODULE_OBJS := \
 	base/scriptables/debuggable/debuggable_script.o \
 	base/scriptables/debuggable/debuggable_script_engine.o \
 	base/scriptables/script.o \
+	base/scriptables/script_atom_table.o \
 	base/scriptables/script_engine.o \
 	base/scriptables/script_stack.o \
 	base/scriptables/script_value.o \
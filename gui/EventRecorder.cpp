@@ -38,6 +38,7 @@ DECLARE_SINGLETON(GUI::EventRecorder);
 #include "gui/onscreendialog.h"
 #include "common/random.h"
 #include "common/savefile.h"
+#include "common/algorithm.h"
 #include "common/textconsole.h"
 #include "graphics/thumbnail.h"
 #include "graphics/surface.h"
@@ -78,6 +79,12 @@ EventRecorder::EventRecorder() {
 	_screenshotPeriod = 0;
 	_playbackFile = nullptr;
 	_recordFile = nullptr;
+	_benchmark = false;
+	_benchmarkReported = false;
+	_lastFrameMicros = 0;
+	_screenChecks = 0;
+	_screenMismatches = 0;
+	_benchmarkFile = nullptr;
 }
 
 EventRecorder::~EventRecorder() {
@@ -89,6 +96,8 @@ void EventRecorder::deinit() {
 		return;
 	}
 	setFileHeader();
+	reportBenchmark();
+	_benchmark = false;
 	_needRedraw = false;
 	_initialized = false;
 	_recordMode = kPassthrough;
@@ -282,12 +291,69 @@ void EventRecorder::processScreenUpdate() {
 		_timerManager->handler();
 		_controlPanel->setReplayedTime(_fakeTimer);
 		_processingMillis = false;
+		if (_benchmark) {
+			updateBenchmark();
+		}
 		break;
 	default:
 		break;
 	}
 }
 
+void EventRecorder::updateBenchmark() {
+	// A frame lasts from one screen update to the next one. The replayed
+	// time is not used as playback does not wait for it.
+	const uint64 now = g_system->getMicros();
+	if (_lastFrameMicros != 0) {
+		const uint32 frameTime = (uint32)MIN<uint64>(now - _lastFrameMicros, 0xFFFFFFFF);
+		_frameTimes.push_back(frameTime);
+		if (_benchmarkFile) {
+			_benchmarkFile->writeString(Common::String::format("%u,%u,%u\n", _frameTimes.size(), _fakeTimer, frameTime));
+		}
+	}
+	_lastFrameMicros = now;
+}
+
+void EventRecorder::processScreenCheck(bool match) {
+	_screenChecks++;
+	if (!match) {
+		_screenMismatches++;
+	}
+}
+
+static uint32 getPercentile(const Common::Array<uint32> &sorted, uint percent) {
+	return sorted[(sorted.size() - 1) * percent / 100];
+}
+
+void EventRecorder::reportBenchmark() {
+	if (!_benchmark || _benchmarkReported) {
+		return;
+	}
+	_benchmarkReported = true;
+
+	if (_benchmarkFile) {
+		_benchmarkFile->finalize();
+		delete _benchmarkFile;
+		_benchmarkFile = nullptr;
+	}
+
+	debug("benchmark:screenshots=%u mismatches=%u", _screenChecks, _screenMismatches);
+	if (_frameTimes.empty()) {
+		debug("benchmark:frames=0");
+		return;
+	}
+
+	Common::Array<uint32> sorted(_frameTimes);
+	Common::sort(sorted.begin(), sorted.end());
+	uint64 total = 0;
+	for (uint i = 0; i < sorted.size(); i++) {
+		total += sorted[i];
+	}
+	debug("benchmark:frames=%u replayed_ms=%u total_ms=%u avg_us=%u p50_us=%u p90_us=%u p99_us=%u max_us=%u",
+		  sorted.size(), _fakeTimer, (uint32)(total / 1000), (uint32)(total / sorted.size()),
+		  getPercentile(sorted, 50), getPercentile(sorted, 90), getPercentile(sorted, 99), sorted.back());
+}
+
 void EventRecorder::checkForKeyCode(const Common::Event &event) {
 	if ((event.type == Common::EVENT_KEYDOWN) && (event.kbd.flags & Common::KBD_CTRL) && (event.kbd.keycode == Common::KEYCODE_p) && (!event.kbdRepeat)) {
 		togglePause();
@@ -380,7 +446,7 @@ Common::String EventRecorder::generateRecordFileName(const Common::String &targe
 }
 
 
-void EventRecorder::init(const Common::String &recordFileName, RecordMode mode) {
+void EventRecorder::init(const Common::String &recordFileName, RecordMode mode, bool benchmark) {
 	_fakeMixerManager = new NullMixerManager();
 	_fakeMixerManager->init();
 	_fakeMixerManager->suspendAudio();
@@ -417,6 +483,27 @@ void EventRecorder::init(const Common::String &recordFileName, RecordMode mode)
 		applyPlaybackSettings();
 		_nextEvent = _playbackFile->getNextEvent();
 	}
+	_benchmark = benchmark && (_recordMode == kRecorderPlayback);
+	if (_benchmark) {
+		debugC(1, kDebugLevelEventRec, "playback:action=\"Start benchmark\"");
+		// do not wait for the recorded delays and do not draw the control panel
+		_fastPlayback = true;
+		_benchmarkReported = false;
+		_lastFrameMicros = 0;
+		_frameTimes.clear();
+		_screenChecks = 0;
+		_screenMismatches = 0;
+		if (ConfMan.hasKey("benchmark_output")) {
+			_benchmarkFile = new Common::DumpFile();
+			if (_benchmarkFile->open(ConfMan.getPath("benchmark_output"))) {
+				_benchmarkFile->writeString("frame,replayed_ms,frame_us\n");
+			} else {
+				warning("Can't open benchmark output file");
+				delete _benchmarkFile;
+				_benchmarkFile = nullptr;
+			}
+		}
+	}
 	if ((_recordMode == kRecorderRecord) || (_recordMode == kRecorderUpdate)) {
 		getConfig();
 	}
@@ -699,6 +786,9 @@ Common::SaveFileManager *EventRecorder::getSaveManager(Common::SaveFileManager *
 }
 
 void EventRecorder::preDrawOverlayGui() {
+	if (_benchmark) {
+		return;
+	}
 	if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -716,6 +806,9 @@ void EventRecorder::preDrawOverlayGui() {
 }
 
 void EventRecorder::postDrawOverlayGui() {
+	if (_benchmark) {
+		return;
+	}
 	if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
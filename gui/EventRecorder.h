@@ -38,6 +38,7 @@
 #include "backends/mixer/mixer.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
+#include "common/file.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "common/config-manager.h"
 #include "common/recorderfile.h"
@@ -77,7 +78,14 @@ public:
 		kRecorderUpdate = 4			/**< kRecorderUpdate, playback existing recording and update all hashes */
 	};
 
-	void init(const Common::String &recordFileName, RecordMode mode);
+	/**
+	 * Start recording or playing back.
+	 *
+	 * @param benchmark  when playing back, replay as fast as possible and
+	 *                   collect frame times, which are reported when the
+	 *                   playback ends
+	 */
+	void init(const Common::String &recordFileName, RecordMode mode, bool benchmark = false);
 	void deinit();
 	bool processDelayMillis();
 	uint32 getRandomSeed(const Common::String &name);
@@ -187,6 +195,11 @@ public:
 	bool switchMode();
 	void switchFastMode();
 
+	/** Called by the playback file after comparing a recorded screenshot */
+	void processScreenCheck(bool match);
+	/** Print the frame time statistics of a benchmark playback */
+	void reportBenchmark();
+
 private:
 	bool pollEvent(Common::Event &ev) override;
 	bool notifyEvent(const Common::Event &event) override;
@@ -244,11 +257,20 @@ private:
 	void checkRecordedMD5();
 	void deleteTemporarySave();
 	void updateFakeTimer(uint32 millis);
+	void updateBenchmark();
 	volatile RecordMode _recordMode;
 	Common::String _recordFileName;
 	bool _fastPlayback;
 	bool _needRedraw;
 	bool _processingMillis;
+
+	bool _benchmark;
+	bool _benchmarkReported;
+	uint64 _lastFrameMicros;
+	Common::Array<uint32> _frameTimes;
+	uint32 _screenChecks;
+	uint32 _screenMismatches;
+	Common::DumpFile *_benchmarkFile;
 };
 
 } // End of namespace GUI
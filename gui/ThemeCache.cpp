@@ -0,0 +1,580 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/crc.h"
+#include "common/file.h"
+#include "common/fs.h"
+#include "common/textconsole.h"
+
+#include "graphics/VectorRenderer.h"
+
+#include "gui/ThemeCache.h"
+#include "gui/ThemeEval.h"
+#include "gui/ThemeParser.h"
+
+namespace GUI {
+
+#define THEME_CACHE_TAG MKTAG('S','T','X','C')
+#define THEME_CACHE_VERSION 2
+
+ThemeCache::ThemeCache() {
+	reset();
+}
+
+void ThemeCache::reset() {
+	_calls.reset(new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES));
+}
+
+void ThemeCache::writeString(const Common::String &str) {
+	_calls->writeUint32LE(str.size());
+	_calls->writeString(str);
+}
+
+Common::String ThemeCache::readString(Common::ReadStream &stream) {
+	const uint32 size = stream.readUint32LE();
+	return stream.readString(0, size);
+}
+
+void ThemeCache::recordFontNames(TextData textId, const Common::String &language, const Common::String &file, const Common::String &scalableFile, int pointsize) {
+	_calls->writeByte(kOpFontNames);
+	_calls->writeSint32LE(textId);
+	writeString(language);
+	writeString(file);
+	writeString(scalableFile);
+	_calls->writeSint32LE(pointsize);
+}
+
+void ThemeCache::recordFont(TextData textId, const Common::String &language, const Common::String &file, const Common::String &scalableFile, int pointsize) {
+	_calls->writeByte(kOpFont);
+	_calls->writeSint32LE(textId);
+	writeString(language);
+	writeString(file);
+	writeString(scalableFile);
+	_calls->writeSint32LE(pointsize);
+}
+
+void ThemeCache::recordTextColor(TextColor colorId, int r, int g, int b) {
+	_calls->writeByte(kOpTextColor);
+	_calls->writeSint32LE(colorId);
+	_calls->writeByte(r);
+	_calls->writeByte(g);
+	_calls->writeByte(b);
+}
+
+void ThemeCache::recordCursor(const Common::String &filename, int hotspotX, int hotspotY) {
+	_calls->writeByte(kOpCursor);
+	writeString(filename);
+	_calls->writeSint32LE(hotspotX);
+	_calls->writeSint32LE(hotspotY);
+}
+
+void ThemeCache::recordBitmap(const Common::String &filename, const Common::String &scalableFile, int width, int height) {
+	_calls->writeByte(kOpBitmap);
+	writeString(filename);
+	writeString(scalableFile);
+	_calls->writeSint32LE(width);
+	_calls->writeSint32LE(height);
+}
+
+void ThemeCache::recordTextData(const Common::String &drawDataId, TextData textId, TextColor colorId, Graphics::TextAlign alignH, ThemeEngine::TextAlignVertical alignV) {
+	_calls->writeByte(kOpTextData);
+	writeString(drawDataId);
+	_calls->writeSint32LE(textId);
+	_calls->writeSint32LE(colorId);
+	_calls->writeSint32LE(alignH);
+	_calls->writeSint32LE(alignV);
+}
+
+void ThemeCache::recordDrawData(const Common::String &drawDataId, bool cached) {
+	_calls->writeByte(kOpDrawData);
+	writeString(drawDataId);
+	_calls->writeByte(cached);
+}
+
+static void writeColor(Common::WriteStream &out, const Graphics::DrawStep::Color &color) {
+	out.writeByte(color.r);
+	out.writeByte(color.g);
+	out.writeByte(color.b);
+	out.writeByte(color.set);
+}
+
+static void readColor(Common::ReadStream &in, Graphics::DrawStep::Color &color) {
+	color.r = in.readByte();
+	color.g = in.readByte();
+	color.b = in.readByte();
+	color.set = in.readByte() != 0;
+}
+
+static void writeRect(Common::WriteStream &out, const Common::Rect &rect) {
+	out.writeSint16LE(rect.left);
+	out.writeSint16LE(rect.top);
+	out.writeSint16LE(rect.right);
+	out.writeSint16LE(rect.bottom);
+}
+
+static void readRect(Common::ReadStream &in, Common::Rect &rect) {
+	rect.left = in.readSint16LE();
+	rect.top = in.readSint16LE();
+	rect.right = in.readSint16LE();
+	rect.bottom = in.readSint16LE();
+}
+
+void ThemeCache::recordDrawStep(const Common::String &drawDataId, const Common::String &function, const Common::String &bitmap, const Graphics::DrawStep &step) {
+	_calls->writeByte(kOpDrawStep);
+	writeString(drawDataId);
+	// The drawing function and the bitmap are pointers, store their names
+	writeString(function);
+	writeString(bitmap);
+
+	_calls->writeSint32LE(step.alphaType);
+	writeColor(*_calls, step.fgColor);
+	writeColor(*_calls, step.bgColor);
+	writeColor(*_calls, step.gradColor1);
+	writeColor(*_calls, step.gradColor2);
+	writeColor(*_calls, step.bevelColor);
+	_calls->writeByte(step.autoWidth);
+	_calls->writeByte(step.autoHeight);
+	_calls->writeSint16LE(step.x);
+	_calls->writeSint16LE(step.y);
+	_calls->writeSint16LE(step.w);
+	_calls->writeSint16LE(step.h);
+	writeRect(*_calls, step.padding);
+	writeRect(*_calls, step.clip);
+	_calls->writeSint32LE(step.xAlign);
+	_calls->writeSint32LE(step.yAlign);
+	_calls->writeByte(step.shadow);
+	_calls->writeByte(step.stroke);
+	_calls->writeByte(step.factor);
+	_calls->writeByte(step.radius);
+	_calls->writeByte(step.bevel);
+	_calls->writeByte(step.fillMode);
+	_calls->writeByte(step.shadowFillMode);
+	_calls->writeUint32LE(step.extraData);
+	_calls->writeUint32LE(step.scale);
+	_calls->writeUint32LE(step.shadowIntensity);
+	_calls->writeSint32LE(step.autoscale);
+}
+
+void ThemeCache::recordVar(const Common::String &name, int value) {
+	_calls->writeByte(kOpVar);
+	writeString(name);
+	_calls->writeSint32LE(value);
+}
+
+void ThemeCache::recordDialog(const Common::String &name, const Common::String &overlays, int16 maxWidth, int16 maxHeight, int inset) {
+	_calls->writeByte(kOpDialog);
+	writeString(name);
+	writeString(overlays);
+	_calls->writeSint16LE(maxWidth);
+	_calls->writeSint16LE(maxHeight);
+	_calls->writeSint32LE(inset);
+}
+
+void ThemeCache::recordImportedLayout(const Common::String &name) {
+	_calls->writeByte(kOpImportedLayout);
+	writeString(name);
+}
+
+void ThemeCache::recordLayout(ThemeLayout::LayoutType type, int spacing, ThemeLayout::ItemAlign itemAlign) {
+	_calls->writeByte(kOpLayout);
+	_calls->writeSint32LE(type);
+	_calls->writeSint32LE(spacing);
+	_calls->writeSint32LE(itemAlign);
+}
+
+void ThemeCache::recordPadding(int16 l, int16 r, int16 t, int16 b) {
+	_calls->writeByte(kOpPadding);
+	_calls->writeSint16LE(l);
+	_calls->writeSint16LE(r);
+	_calls->writeSint16LE(t);
+	_calls->writeSint16LE(b);
+}
+
+void ThemeCache::recordWidget(const Common::String &name, const Common::String &type, int w, int h, Graphics::TextAlign align, bool useRTL) {
+	_calls->writeByte(kOpWidget);
+	writeString(name);
+	writeString(type);
+	_calls->writeSint32LE(w);
+	_calls->writeSint32LE(h);
+	_calls->writeSint32LE(align);
+	_calls->writeByte(useRTL);
+}
+
+void ThemeCache::recordSpace(int size) {
+	_calls->writeByte(kOpSpace);
+	_calls->writeSint32LE(size);
+}
+
+void ThemeCache::recordCloseLayout() {
+	_calls->writeByte(kOpCloseLayout);
+}
+
+void ThemeCache::recordCloseDialog() {
+	_calls->writeByte(kOpCloseDialog);
+}
+
+bool ThemeCache::save(const Common::Path &filename, const Common::String &key, const ThemeEngine::ImagesMap &bitmaps) {
+	// The contents are assembled in memory first so that their checksum
+	// can be written ahead of them
+	Common::MemoryWriteStreamDynamic body(DisposeAfterUse::YES);
+	body.writeUint32LE(key.size());
+	body.writeString(key);
+
+	// Bitmaps are stored as decoded, converted and scaled by the theme
+	// engine, in the pixel format of the overlay which is part of the key
+	uint32 count = 0;
+	for (const auto &bitmap : bitmaps) {
+		if (bitmap._value)
+			count++;
+	}
+	body.writeUint32LE(count);
+
+	for (const auto &bitmap : bitmaps) {
+		const Graphics::ManagedSurface *surf = bitmap._value;
+		if (!surf)
+			continue;
+
+		body.writeUint32LE(bitmap._key.size());
+		body.writeString(bitmap._key);
+		body.writeUint16LE(surf->w);
+		body.writeUint16LE(surf->h);
+		body.writeByte(surf->format.bytesPerPixel);
+		body.writeByte(surf->format.rLoss);
+		body.writeByte(surf->format.gLoss);
+		body.writeByte(surf->format.bLoss);
+		body.writeByte(surf->format.aLoss);
+		body.writeByte(surf->format.rShift);
+		body.writeByte(surf->format.gShift);
+		body.writeByte(surf->format.bShift);
+		body.writeByte(surf->format.aShift);
+		body.writeByte(surf->hasTransparentColor());
+		body.writeUint32LE(surf->getTransparentColor());
+
+		const uint32 lineSize = surf->w * surf->format.bytesPerPixel;
+		for (int y = 0; y < surf->h; y++)
+			body.write(surf->getBasePtr(0, y), lineSize);
+	}
+
+	body.write(_calls->getData(), _calls->size());
+	body.writeByte(kOpEnd);
+
+	Common::DumpFile out;
+	if (!out.open(filename, true)) {
+		warning("ThemeCache::save: Couldn't open file '%s' for writing", filename.toString(Common::Path::kNativeSeparator).c_str());
+		return false;
+	}
+
+	// A file left incomplete by a crash fails the size or checksum test
+	Common::CRC32 crc;
+	out.writeUint32BE(THEME_CACHE_TAG);
+	out.writeUint32BE(THEME_CACHE_VERSION);
+	out.writeUint32LE(body.size());
+	out.writeUint32LE(crc.crcFast(body.getData(), body.size()));
+	out.write(body.getData(), body.size());
+
+	if (!out.flush() || out.err()) {
+		warning("ThemeCache::save: Failed to write '%s'", filename.toString(Common::Path::kNativeSeparator).c_str());
+		return false;
+	}
+
+	return true;
+}
+
+bool ThemeCache::load(const Common::Path &filename, const Common::String &key, ThemeEngine *theme, ThemeEngine::ImagesMap &bitmaps) {
+	Common::FSNode node(filename);
+	if (!node.exists())
+		return false;
+
+	Common::File file;
+	if (!file.open(node))
+		return false;
+
+	if (file.readUint32BE() != THEME_CACHE_TAG || file.readUint32BE() != THEME_CACHE_VERSION)
+		return false;
+
+	const uint32 size = file.readUint32LE();
+	const uint32 checksum = file.readUint32LE();
+	if (file.eos() || size != file.size() - file.pos())
+		return false;
+
+	byte *data = (byte *)malloc(size);
+	if (!data)
+		return false;
+	Common::MemoryReadStream in(data, size, DisposeAfterUse::YES);
+	Common::CRC32 crc;
+	if (file.read(data, size) != size || crc.crcFast(data, size) != checksum)
+		return false;
+
+	if (readString(in) != key)
+		return false;
+
+	// Bitmaps are collected apart until the whole file has been read, and
+	// taken back if the replay fails, so that the theme never keeps bitmaps
+	// from a cache it did not use
+	ThemeEngine::ImagesMap loaded;
+	bool valid = true;
+
+	const uint32 count = in.readUint32LE();
+	for (uint32 i = 0; i < count && valid; i++) {
+		const Common::String name = readString(in);
+		const uint16 w = in.readUint16LE();
+		const uint16 h = in.readUint16LE();
+		Graphics::PixelFormat format;
+		format.bytesPerPixel = in.readByte();
+		format.rLoss = in.readByte();
+		format.gLoss = in.readByte();
+		format.bLoss = in.readByte();
+		format.aLoss = in.readByte();
+		format.rShift = in.readByte();
+		format.gShift = in.readByte();
+		format.bShift = in.readByte();
+		format.aShift = in.readByte();
+		const bool hasTransparentColor = in.readByte() != 0;
+		const uint32 transparentColor = in.readUint32LE();
+
+		const uint32 lineSize = w * format.bytesPerPixel;
+		if (in.eos() || format.bytesPerPixel < 1 || format.bytesPerPixel > 4 ||
+		    (uint64)lineSize * h > (uint64)(in.size() - in.pos())) {
+			valid = false;
+			break;
+		}
+
+		if ((bitmaps.contains(name) && bitmaps[name]) || loaded.contains(name)) {
+			// Already loaded before a refresh
+			in.skip(lineSize * h);
+			continue;
+		}
+
+		Graphics::ManagedSurface *surf = new Graphics::ManagedSurface(w, h, format);
+		for (int y = 0; y < h; y++)
+			in.read(surf->getBasePtr(0, y), lineSize);
+		if (hasTransparentColor)
+			surf->setTransparentColor(transparentColor);
+		loaded[name] = surf;
+	}
+
+	if (valid && !in.eos() && !in.err()) {
+		// The replayed calls refer to the bitmaps
+		for (auto &bitmap : loaded)
+			bitmaps[bitmap._key] = bitmap._value;
+
+		if (replay(in, theme))
+			return true;
+
+		for (auto &bitmap : loaded)
+			bitmaps.erase(bitmap._key);
+	}
+
+	for (auto &bitmap : loaded)
+		delete bitmap._value;
+	return false;
+}
+
+bool ThemeCache::replay(Common::SeekableReadStream &in, ThemeEngine *theme) {
+	ThemeEval *eval = theme->getEvaluator();
+
+	while (!in.eos() && !in.err()) {
+		const byte op = in.readByte();
+		switch (op) {
+		case kOpEnd:
+			return true;
+
+		case kOpFontNames:
+		case kOpFont: {
+			const TextData textId = (TextData)in.readSint32LE();
+			const Common::String language = readString(in);
+			const Common::String file = readString(in);
+			const Common::String scalableFile = readString(in);
+			const int pointsize = in.readSint32LE();
+			if (op == kOpFontNames)
+				theme->storeFontNames(textId, language, file, scalableFile, pointsize);
+			else if (!theme->addFont(textId, language, file, scalableFile, pointsize))
+				return false;
+			break;
+		}
+
+		case kOpTextColor: {
+			const TextColor colorId = (TextColor)in.readSint32LE();
+			const int r = in.readByte();
+			const int g = in.readByte();
+			const int b = in.readByte();
+			if (!theme->addTextColor(colorId, r, g, b))
+				return false;
+			break;
+		}
+
+		case kOpCursor: {
+			const Common::String filename = readString(in);
+			const int hotspotX = in.readSint32LE();
+			const int hotspotY = in.readSint32LE();
+			if (!theme->createCursor(filename, hotspotX, hotspotY))
+				return false;
+			break;
+		}
+
+		case kOpBitmap: {
+			const Common::String filename = readString(in);
+			const Common::String scalableFile = readString(in);
+			const int width = in.readSint32LE();
+			const int height = in.readSint32LE();
+			if (!theme->addBitmap(filename, scalableFile, width, height))
+				return false;
+			break;
+		}
+
+		case kOpTextData: {
+			const Common::String drawDataId = readString(in);
+			const TextData textId = (TextData)in.readSint32LE();
+			const TextColor colorId = (TextColor)in.readSint32LE();
+			const Graphics::TextAlign alignH = (Graphics::TextAlign)in.readSint32LE();
+			const ThemeEngine::TextAlignVertical alignV = (ThemeEngine::TextAlignVertical)in.readSint32LE();
+			if (!theme->addTextData(drawDataId, textId, colorId, alignH, alignV))
+				return false;
+			break;
+		}
+
+		case kOpDrawData: {
+			const Common::String drawDataId = readString(in);
+			const bool cached = in.readByte() != 0;
+			if (!theme->addDrawData(drawDataId, cached))
+				return false;
+			break;
+		}
+
+		case kOpDrawStep: {
+			const Common::String drawDataId = readString(in);
+			const Common::String function = readString(in);
+			const Common::String bitmap = readString(in);
+
+			Graphics::DrawStep step;
+			step.drawingCall = ThemeParser::getDrawingFunctionCallback(function);
+			if (!step.drawingCall)
+				return false;
+			if (!bitmap.empty()) {
+				step.blitSrc = theme->getImageSurface(bitmap);
+				if (!step.blitSrc)
+					return false;
+			}
+
+			step.alphaType = (Graphics::AlphaType)in.readSint32LE();
+			readColor(in, step.fgColor);
+			readColor(in, step.bgColor);
+			readColor(in, step.gradColor1);
+			readColor(in, step.gradColor2);
+			readColor(in, step.bevelColor);
+			step.autoWidth = in.readByte() != 0;
+			step.autoHeight = in.readByte() != 0;
+			step.x = in.readSint16LE();
+			step.y = in.readSint16LE();
+			step.w = in.readSint16LE();
+			step.h = in.readSint16LE();
+			readRect(in, step.padding);
+			readRect(in, step.clip);
+			step.xAlign = (Graphics::DrawStep::VectorAlignment)in.readSint32LE();
+			step.yAlign = (Graphics::DrawStep::VectorAlignment)in.readSint32LE();
+			step.shadow = in.readByte();
+			step.stroke = in.readByte();
+			step.factor = in.readByte();
+			step.radius = in.readByte();
+			step.bevel = in.readByte();
+			step.fillMode = in.readByte();
+			step.shadowFillMode = in.readByte();
+			step.extraData = in.readUint32LE();
+			step.scale = in.readUint32LE();
+			step.shadowIntensity = in.readUint32LE();
+			step.autoscale = (ThemeEngine::AutoScaleMode)in.readSint32LE();
+
+			theme->addDrawStep(drawDataId, step);
+			break;
+		}
+
+		case kOpVar: {
+			const Common::String name = readString(in);
+			eval->setVar(name, in.readSint32LE());
+			break;
+		}
+
+		case kOpDialog: {
+			const Common::String name = readString(in);
+			const Common::String overlays = readString(in);
+			const int16 maxWidth = in.readSint16LE();
+			const int16 maxHeight = in.readSint16LE();
+			eval->addDialog(name, overlays, maxWidth, maxHeight, in.readSint32LE());
+			break;
+		}
+
+		case kOpImportedLayout: {
+			const Common::String name = readString(in);
+			if (!eval->hasDialog(name))
+				return false;
+			eval->addImportedLayout(name);
+			break;
+		}
+
+		case kOpLayout: {
+			const ThemeLayout::LayoutType type = (ThemeLayout::LayoutType)in.readSint32LE();
+			const int spacing = in.readSint32LE();
+			eval->addLayout(type, spacing, (ThemeLayout::ItemAlign)in.readSint32LE());
+			break;
+		}
+
+		case kOpPadding: {
+			const int16 l = in.readSint16LE();
+			const int16 r = in.readSint16LE();
+			const int16 t = in.readSint16LE();
+			eval->addPadding(l, r, t, in.readSint16LE());
+			break;
+		}
+
+		case kOpWidget: {
+			const Common::String name = readString(in);
+			const Common::String type = readString(in);
+			const int w = in.readSint32LE();
+			const int h = in.readSint32LE();
+			const Graphics::TextAlign align = (Graphics::TextAlign)in.readSint32LE();
+			eval->addWidget(name, type, w, h, align, in.readByte() != 0);
+			break;
+		}
+
+		case kOpSpace:
+			eval->addSpace(in.readSint32LE());
+			break;
+
+		case kOpCloseLayout:
+			eval->closeLayout();
+			break;
+
+		case kOpCloseDialog:
+			eval->closeDialog();
+			break;
+
+		default:
+			warning("ThemeCache: Unknown opcode %d", op);
+			return false;
+		}
+	}
+
+	// The file ended before kOpEnd
+	return false;
+}
+
+} // End of namespace GUI
@@ -0,0 +1,127 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef GUI_THEME_CACHE_H
+#define GUI_THEME_CACHE_H
+
+#include "common/scummsys.h"
+#include "common/memstream.h"
+#include "common/path.h"
+#include "common/ptr.h"
+#include "common/str.h"
+
+#include "gui/ThemeEngine.h"
+#include "gui/ThemeLayout.h"
+
+namespace Graphics {
+struct DrawStep;
+}
+
+namespace GUI {
+
+/**
+ * Binary cache of a parsed theme.
+ *
+ * While a theme is parsed, the ThemeParser records here the calls it makes
+ * to the ThemeEngine and its ThemeEval. These calls, together with the
+ * decoded and scaled bitmaps, are then written to a file. When the same
+ * theme is loaded again at the same resolution, replaying the calls from
+ * the file replaces parsing the XML and decoding the images.
+ */
+class ThemeCache {
+public:
+	ThemeCache();
+
+	/** Discard the recorded calls and start recording again. */
+	void reset();
+
+	void recordFontNames(TextData textId, const Common::String &language, const Common::String &file, const Common::String &scalableFile, int pointsize);
+	void recordFont(TextData textId, const Common::String &language, const Common::String &file, const Common::String &scalableFile, int pointsize);
+	void recordTextColor(TextColor colorId, int r, int g, int b);
+	void recordCursor(const Common::String &filename, int hotspotX, int hotspotY);
+	void recordBitmap(const Common::String &filename, const Common::String &scalableFile, int width, int height);
+	void recordTextData(const Common::String &drawDataId, TextData textId, TextColor colorId, Graphics::TextAlign alignH, ThemeEngine::TextAlignVertical alignV);
+	void recordDrawData(const Common::String &drawDataId, bool cached);
+	void recordDrawStep(const Common::String &drawDataId, const Common::String &function, const Common::String &bitmap, const Graphics::DrawStep &step);
+	void recordVar(const Common::String &name, int value);
+	void recordDialog(const Common::String &name, const Common::String &overlays, int16 maxWidth, int16 maxHeight, int inset);
+	void recordImportedLayout(const Common::String &name);
+	void recordLayout(ThemeLayout::LayoutType type, int spacing, ThemeLayout::ItemAlign itemAlign);
+	void recordPadding(int16 l, int16 r, int16 t, int16 b);
+	void recordWidget(const Common::String &name, const Common::String &type, int w, int h, Graphics::TextAlign align, bool useRTL);
+	void recordSpace(int size);
+	void recordCloseLayout();
+	void recordCloseDialog();
+
+	/**
+	 * Write the recorded calls and the given bitmaps to a cache file.
+	 *
+	 * @param filename  File to write.
+	 * @param key       Identifies the theme contents, resolution and pixel format.
+	 * @param bitmaps   Bitmaps loaded by the theme.
+	 */
+	bool save(const Common::Path &filename, const Common::String &key, const ThemeEngine::ImagesMap &bitmaps);
+
+	/**
+	 * Set up a theme from a cache file written by save().
+	 *
+	 * The bitmaps the theme has not loaded yet are added to @p bitmaps,
+	 * then the recorded calls are replayed on @p theme.
+	 *
+	 * @return false if the file does not exist, is damaged, does not match
+	 *         @p key or if a call failed. Nothing is added to @p bitmaps
+	 *         then, and the theme must be unloaded and parsed.
+	 */
+	static bool load(const Common::Path &filename, const Common::String &key, ThemeEngine *theme, ThemeEngine::ImagesMap &bitmaps);
+
+private:
+	enum Opcode {
+		kOpEnd,
+		kOpFontNames,
+		kOpFont,
+		kOpTextColor,
+		kOpCursor,
+		kOpBitmap,
+		kOpTextData,
+		kOpDrawData,
+		kOpDrawStep,
+		kOpVar,
+		kOpDialog,
+		kOpImportedLayout,
+		kOpLayout,
+		kOpPadding,
+		kOpWidget,
+		kOpSpace,
+		kOpCloseLayout,
+		kOpCloseDialog
+	};
+
+	void writeString(const Common::String &str);
+	static Common::String readString(Common::ReadStream &stream);
+	static bool replay(Common::SeekableReadStream &stream, ThemeEngine *theme);
+
+	Common::ScopedPtr<Common::MemoryWriteStreamDynamic> _calls;
+};
+
+} // End of namespace GUI
+
+#endif
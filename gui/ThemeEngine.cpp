@@ -19,10 +19,14 @@
  *
  */
 
+#include "base/version.h"
+
 #include "common/system.h"
 #include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/md5.h"
+#include "common/memstream.h"
 #include "common/compression/unzip.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
@@ -41,6 +45,7 @@
 #include "image/png.h"
 
 #include "gui/widget.h"
+#include "gui/ThemeCache.h"
 #include "gui/ThemeEngine.h"
 #include "gui/ThemeEval.h"
 #include "gui/ThemeParser.h"
@@ -189,7 +194,7 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_system(nullptr), _vectorRenderer(nullptr),
 	_layerToDraw(kDrawLayerBackground), _bytesPerPixel(0),  _graphicsMode(kGfxDisabled),
 	_font(nullptr), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
-	_cursor(nullptr), _scaleFactor(1.0f) {
+	_themeCacheWrites(0), _cursor(nullptr), _scaleFactor(1.0f) {
 
 	_baseWidth = 640;	// Default sane values
 	_baseHeight = 480;
@@ -835,21 +840,34 @@ bool ThemeEngine::loadDefaultXML() {
 	for (int i = 0; i < ARRAYSIZE(defaultXML); i++)
 		strncat((char *)tmpXML, defaultXML[i], xmllen);
 
+	_themeName = "ScummVM Classic Theme (Builtin Version)";
+	_themeId = "builtin";
+	_themeFile.clear();
+
+	Common::MemoryReadStream xmlStream(tmpXML, xmllen);
+	const Common::String cacheKey = getThemeCacheKey(Common::computeStreamMD5AsString(xmlStream));
+	if (loadThemeCache(cacheKey)) {
+		free(tmpXML);
+		return true;
+	}
+
 	if (!_parser->loadBuffer(tmpXML, xmllen)) {
 		free(tmpXML);
 
 		return false;
 	}
 
-	_themeName = "ScummVM Classic Theme (Builtin Version)";
-	_themeId = "builtin";
-	_themeFile.clear();
-
+	ThemeCache cache;
+	_parser->setCache(&cache);
 	bool result = _parser->parse();
+	_parser->setCache(nullptr);
 	_parser->close();
 
 	free(tmpXML);
 
+	if (result)
+		saveThemeCache(cacheKey, cache);
+
 	return result;
 #else
 	warning("The built-in theme is not enabled in the current build. Please load an external theme");
@@ -886,20 +904,65 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 		return false;
 	}
 
+	//
+	// Skip the parsing if the STX files have not changed since
+	// the theme was last loaded at this resolution
+	//
+	Common::String digest = stxHeader;
+	for (auto &member : members) {
+		Common::ScopedPtr<Common::SeekableReadStream> stream(member->createReadStream());
+		if (!stream)
+			break;
+		digest += ":" + Common::computeStreamMD5AsString(*stream);
+	}
+
+	//
+	// The cache also holds the decoded images, so they must invalidate it
+	// too. Their sizes are enough for that: reading them from a zip theme
+	// would cost as much as decoding them, so the size of the zip file
+	// stands for all of its members then.
+	//
+	Common::FSNode themeNode(_themeFile);
+	if (themeNode.isDirectory()) {
+		Common::ArchiveMemberList images;
+		_themeArchive->listMembers(images);
+		for (auto &member : images) {
+			if (member->getName().hasSuffix(".stx"))
+				continue;
+			Common::ScopedPtr<Common::SeekableReadStream> stream(member->createReadStream());
+			if (stream)
+				digest += Common::String::format(":%s=%d", member->getName().c_str(), (int)stream->size());
+		}
+	} else {
+		Common::ArchiveMemberPtr zipMember = SearchMan.getMember(_themeFile);
+		Common::ScopedPtr<Common::SeekableReadStream> stream(zipMember ? zipMember->createReadStream() : themeNode.createReadStream());
+		if (stream)
+			digest += Common::String::format(":%d", (int)stream->size());
+	}
+
+	const Common::String cacheKey = getThemeCacheKey(digest);
+	if (loadThemeCache(cacheKey))
+		return true;
+
 	//
 	// Loop over all STX files, load and parse them
 	//
+	ThemeCache cache;
+	_parser->setCache(&cache);
+
 	for (auto &member : members) {
 		assert(member->getName().hasSuffix(".stx"));
 
 		if (_parser->loadStream(member->createReadStream()) == false) {
 			warning("Failed to load STX file '%s'", member->getName().c_str());
+			_parser->setCache(nullptr);
 			_parser->close();
 			return false;
 		}
 
 		if (_parser->parse() == false) {
 			warning("Failed to parse STX file '%s'", member->getName().c_str());
+			_parser->setCache(nullptr);
 			_parser->close();
 			return false;
 		}
@@ -907,10 +970,65 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 		_parser->close();
 	}
 
+	_parser->setCache(nullptr);
+	saveThemeCache(cacheKey, cache);
+
 	assert(!_themeName.empty());
 	return true;
 }
 
+Common::String ThemeEngine::getThemeCacheKey(const Common::String &digest) const {
+	return Common::String::format("%s|%s|%dx%d|%f|%s", gScummVMFullVersion, digest.c_str(),
+	                              _baseWidth, _baseHeight, _scaleFactor, _overlayFormat.toString().c_str());
+}
+
+Common::Path ThemeEngine::getThemeCachePath(const Common::String &key) const {
+	// The icons path is a cache directory where the backend has one, and
+	// is empty by default elsewhere. The save path always has a default.
+	Common::Path cacheDir = ConfMan.getPath("iconspath");
+	if (cacheDir.empty())
+		cacheDir = ConfMan.getPath("savepath");
+	if (cacheDir.empty())
+		return Common::Path();
+
+	// Keep a few resolutions of each theme, replacing them as the
+	// window is resized rather than adding a new file every time
+	const uint slot = Common::hashit(key.c_str()) % 4;
+	Common::MemoryReadStream idStream((const byte *)_themeId.c_str(), _themeId.size());
+	const Common::String name = Common::String::format("%s-%u.stxc", Common::computeStreamMD5AsString(idStream).c_str(), slot);
+	return cacheDir.join("themecache").join(name);
+}
+
+bool ThemeEngine::loadThemeCache(const Common::String &key) {
+	const Common::Path path = getThemeCachePath(key);
+	if (path.empty())
+		return false;
+
+	if (ThemeCache::load(path, key, this, _bitmaps)) {
+		debug(6, "Loaded theme %s from cache", _themeId.c_str());
+		return true;
+	}
+
+	// Drop what was set up before the cache turned out to be invalid
+	_themeOk = true;
+	unloadTheme();
+	return false;
+}
+
+void ThemeEngine::saveThemeCache(const Common::String &key, ThemeCache &cache) {
+	// Resizing the window reloads the theme for every step,
+	// only cache the first resolutions of the session
+	if (_themeCacheWrites >= 4)
+		return;
+
+	const Common::Path path = getThemeCachePath(key);
+	if (path.empty())
+		return;
+
+	if (cache.save(path, key, _bitmaps))
+		_themeCacheWrites++;
+}
+
 
 
 /**********************************************************
@@ -51,6 +51,7 @@ struct WidgetDrawData;
 struct TextDrawData;
 class Dialog;
 class GuiObject;
+class ThemeCache;
 class ThemeEval;
 class ThemeParser;
 
@@ -212,6 +213,7 @@ protected:
 
 	friend class GUI::Dialog;
 	friend class GUI::GuiObject;
+	friend class GUI::ThemeCache;
 
 public:
 	/// Vertical alignment of the text.
@@ -682,6 +684,21 @@ protected:
 	 */
 	bool loadDefaultXML();
 
+	/**
+	 * Identify the parsed theme by the digest of its data, the resolution
+	 * and the overlay format, which all affect the result of the parsing.
+	 */
+	Common::String getThemeCacheKey(const Common::String &digest) const;
+
+	/**
+	 * Set up the theme from its binary cache instead of parsing it.
+	 *
+	 * @returns false if there is no valid cache for @p key.
+	 */
+	bool loadThemeCache(const Common::String &key);
+	void saveThemeCache(const Common::String &key, ThemeCache &cache);
+	Common::Path getThemeCachePath(const Common::String &key) const;
+
 	/**
 	 * Unloads the currently loaded theme so another one can
 	 * be loaded.
@@ -816,6 +833,7 @@ protected:
 	Common::Path _themeFile;
 	Common::Archive *_themeArchive;
 	Common::SearchSet _themeFiles;
+	int _themeCacheWrites;
 
 	bool _useCursor;
 	int _cursorHotspotX, _cursorHotspotY;
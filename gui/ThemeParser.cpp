@@ -19,6 +19,7 @@
  *
  */
 
+#include "gui/ThemeCache.h"
 #include "gui/ThemeEngine.h"
 #include "gui/ThemeEval.h"
 #include "gui/ThemeParser.h"
@@ -187,6 +188,7 @@ ThemeParser::ThemeParser(ThemeEngine *parent) : XMLParser() {
 	_defaultStepGlobal = defaultDrawStep();
 	_defaultStepLocal = nullptr;
 	_theme = parent;
+	_cache = nullptr;
 
 	_baseWidth = _baseHeight = 0;
 	_scaleFactor = 1.0f;
@@ -306,9 +308,13 @@ bool ThemeParser::parserCallback_language(ParserNode *node) {
 
 
 	_theme->storeFontNames(textDataId, node->values["id"], file, scalableFile, pointsize);
+	if (_cache)
+		_cache->recordFontNames(textDataId, node->values["id"], file, scalableFile, pointsize);
 
 	if (!_theme->addFont(textDataId, node->values["id"], file, scalableFile, pointsize))
 		return parserError("Error loading localized Font in theme engine.");
+	if (_cache)
+		_cache->recordFont(textDataId, node->values["id"], file, scalableFile, pointsize);
 
 	return true;
 }
@@ -327,6 +333,8 @@ bool ThemeParser::parserCallback_text_color(ParserNode *node) {
 
 	if (!_theme->addTextColor(colorId, red, green, blue))
 		return parserError("Error while adding text color information.");
+	if (_cache)
+		_cache->recordTextColor(colorId, red, green, blue);
 
 	return true;
 }
@@ -348,6 +356,8 @@ bool ThemeParser::parserCallback_cursor(ParserNode *node) {
 
 	if (!_theme->createCursor(node->values["file"], spotx, spoty))
 		return parserError("Error creating Bitmap Cursor.");
+	if (_cache)
+		_cache->recordCursor(node->values["file"], spotx, spoty);
 
 	return true;
 }
@@ -380,6 +390,8 @@ bool ThemeParser::parserCallback_bitmap(ParserNode *node) {
 
 	if (!_theme->addBitmap(node->values["filename"], scalableFile, width, height))
 		return parserError("Error loading Bitmap file '" + node->values["filename"] + "'");
+	if (_cache)
+		_cache->recordBitmap(node->values["filename"], scalableFile, width, height);
 
 	return true;
 }
@@ -400,6 +412,8 @@ bool ThemeParser::parserCallback_text(ParserNode *node) {
 
 	if (!_theme->addTextData(id, textDataId, textColorId, alignH, alignV))
 		return parserError("Error adding Text Data for '" + id + "'.");
+	if (_cache)
+		_cache->recordTextData(id, textDataId, textColorId, alignH, alignV);
 
 	return true;
 }
@@ -442,7 +456,7 @@ bool ThemeParser::parserCallback_color(ParserNode *node) {
 }
 
 
-static Graphics::DrawingFunctionCallback getDrawingFunctionCallback(const Common::String &name) {
+Graphics::DrawingFunctionCallback ThemeParser::getDrawingFunctionCallback(const Common::String &name) {
 
 	if (name == "circle")
 		return &Graphics::VectorRenderer::drawCallback_CIRCLE;
@@ -489,6 +503,9 @@ bool ThemeParser::parserCallback_drawstep(ParserNode *node) {
 	}
 
 	_theme->addDrawStep(getParentNode(node)->values["id"], *drawstep);
+	if (_cache)
+		_cache->recordDrawStep(getParentNode(node)->values["id"], functionName,
+		                       functionName == "bitmap" ? node->values["file"] : Common::String(), *drawstep);
 	delete drawstep;
 
 	return true;
@@ -509,6 +526,8 @@ bool ThemeParser::parserCallback_drawdata(ParserNode *node) {
 
 	if (_theme->addDrawData(node->values["id"], cached) == false)
 		return parserError("Error adding Draw Data set: Invalid DrawData name.");
+	if (_cache)
+		_cache->recordDrawData(node->values["id"], cached);
 
 	delete _defaultStepLocal;
 	_defaultStepLocal = nullptr;
@@ -731,6 +750,12 @@ bool ThemeParser::parseDrawStep(ParserNode *stepNode, Graphics::DrawStep *drawst
 	return true;
 }
 
+void ThemeParser::setEvaluatorVar(const Common::String &name, int value) {
+	_theme->getEvaluator()->setVar(name, value);
+	if (_cache)
+		_cache->recordVar(name, value);
+}
+
 bool ThemeParser::parserCallback_def(ParserNode *node) {
 	if (resolutionCheck(node->values["resolution"]) == false) {
 		node->ignore = true;
@@ -753,7 +778,7 @@ bool ThemeParser::parserCallback_def(ParserNode *node) {
 	if (scalable)
 		value = SCALEVALUE(value);
 
-	_theme->getEvaluator()->setVar(var, value);
+	setEvaluatorVar(var, value);
 	return true;
 }
 
@@ -808,6 +833,8 @@ bool ThemeParser::parserCallback_widget(ParserNode *node) {
 			useRTL = parseBoolean(node->values["rtl"]);
 
 		_theme->getEvaluator()->addWidget(var, node->values["type"], width, height, alignH, useRTL);
+		if (_cache)
+			_cache->recordWidget(var, node->values["type"], width, height, alignH, useRTL);
 	}
 
 	return true;
@@ -845,6 +872,8 @@ bool ThemeParser::parserCallback_dialog(ParserNode *node) {
 	}
 
 	_theme->getEvaluator()->addDialog(name, overlays, SCALEVALUE(width), SCALEVALUE(height), inset);
+	if (_cache)
+		_cache->recordDialog(name, overlays, SCALEVALUE(width), SCALEVALUE(height), inset);
 
 	if (node->values.contains("shading")) {
 		int shading = 0;
@@ -854,7 +883,7 @@ bool ThemeParser::parserCallback_dialog(ParserNode *node) {
 			shading = 2;
 		else return parserError("Invalid value for Dialog background shading.");
 
-		_theme->getEvaluator()->setVar("Dialog." + name + ".Shading", shading);
+		setEvaluatorVar("Dialog." + name + ".Shading", shading);
 	}
 
 	return true;
@@ -867,6 +896,8 @@ bool ThemeParser::parserCallback_import(ParserNode *node) {
 		return parserError("Imported layout was not found: " + importedName);
 
 	_theme->getEvaluator()->addImportedLayout(importedName);
+	if (_cache)
+		_cache->recordImportedLayout(importedName);
 
 	return true;
 }
@@ -903,13 +934,18 @@ bool ThemeParser::parserCallback_layout(ParserNode *node) {
 		}
 	}
 
+	ThemeLayout::LayoutType type;
 	if (node->values["type"] == "vertical")
-		_theme->getEvaluator()->addLayout(GUI::ThemeLayout::kLayoutVertical, spacing, itemAlign);
+		type = GUI::ThemeLayout::kLayoutVertical;
 	else if (node->values["type"] == "horizontal")
-		_theme->getEvaluator()->addLayout(GUI::ThemeLayout::kLayoutHorizontal, spacing, itemAlign);
+		type = GUI::ThemeLayout::kLayoutHorizontal;
 	else
 		return parserError("Invalid layout type. Only 'horizontal' and 'vertical' layouts allowed.");
 
+	_theme->getEvaluator()->addLayout(type, spacing, itemAlign);
+	if (_cache)
+		_cache->recordLayout(type, spacing, itemAlign);
+
 	if (node->values.contains("padding")) {
 		int paddingL, paddingR, paddingT, paddingB;
 
@@ -918,6 +954,8 @@ bool ThemeParser::parserCallback_layout(ParserNode *node) {
 
 		// values are scaled inside this method
 		_theme->getEvaluator()->addPadding(paddingL, paddingR, paddingT, paddingB);
+		if (_cache)
+			_cache->recordPadding(paddingL, paddingR, paddingT, paddingB);
 	}
 
 	return true;
@@ -942,14 +980,21 @@ bool ThemeParser::parserCallback_space(ParserNode *node) {
 	}
 
 	_theme->getEvaluator()->addSpace(size);
+	if (_cache)
+		_cache->recordSpace(size);
 	return true;
 }
 
 bool ThemeParser::closedKeyCallback(ParserNode *node) {
-	if (node->name == "layout")
+	if (node->name == "layout") {
 		_theme->getEvaluator()->closeLayout();
-	else if (node->name == "dialog")
+		if (_cache)
+			_cache->recordCloseLayout();
+	} else if (node->name == "dialog") {
 		_theme->getEvaluator()->closeDialog();
+		if (_cache)
+			_cache->recordCloseDialog();
+	}
 
 	return true;
 }
@@ -1002,8 +1047,8 @@ bool ThemeParser::parseCommonLayoutProps(ParserNode *node, const Common::String
 				return false;
 		}
 
-		_theme->getEvaluator()->setVar(var + "Width", width);
-		_theme->getEvaluator()->setVar(var + "Height", height);
+		setEvaluatorVar(var + "Width", width);
+		setEvaluatorVar(var + "Height", height);
 	}
 
 	if (node->values.contains("pos")) {
@@ -1063,8 +1108,8 @@ bool ThemeParser::parseCommonLayoutProps(ParserNode *node, const Common::String
 				return false;
 		}
 
-		_theme->getEvaluator()->setVar(var + "X", x);
-		_theme->getEvaluator()->setVar(var + "Y", y);
+		setEvaluatorVar(var + "X", x);
+		setEvaluatorVar(var + "Y", y);
 	}
 
 	if (node->values.contains("padding")) {
@@ -1073,10 +1118,10 @@ bool ThemeParser::parseCommonLayoutProps(ParserNode *node, const Common::String
 		if (!parseList(node->values["padding"], 4, &paddingL, &paddingR, &paddingT, &paddingB))
 			return false;
 
-		_theme->getEvaluator()->setVar(var + "Padding.Left", SCALEVALUE(paddingL));
-		_theme->getEvaluator()->setVar(var + "Padding.Right", SCALEVALUE(paddingR));
-		_theme->getEvaluator()->setVar(var + "Padding.Top", SCALEVALUE(paddingT));
-		_theme->getEvaluator()->setVar(var + "Padding.Bottom", SCALEVALUE(paddingB));
+		setEvaluatorVar(var + "Padding.Left", SCALEVALUE(paddingL));
+		setEvaluatorVar(var + "Padding.Right", SCALEVALUE(paddingR));
+		setEvaluatorVar(var + "Padding.Top", SCALEVALUE(paddingT));
+		setEvaluatorVar(var + "Padding.Bottom", SCALEVALUE(paddingB));
 	}
 
 
@@ -1086,7 +1131,7 @@ bool ThemeParser::parseCommonLayoutProps(ParserNode *node, const Common::String
 		if ((alignH = parseTextHAlign(node->values["textalign"])) == Graphics::kTextAlignInvalid)
 			return parserError("Invalid value for text alignment.");
 
-		_theme->getEvaluator()->setVar(var + "Align", alignH);
+		setEvaluatorVar(var + "Align", alignH);
 	}
 	return true;
 }
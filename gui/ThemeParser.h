@@ -25,8 +25,11 @@
 #include "common/scummsys.h"
 #include "common/formats/xmlparser.h"
 
+#include "graphics/VectorRenderer.h"
+
 namespace GUI {
 
+class ThemeCache;
 class ThemeEngine;
 
 class ThemeParser : public Common::XMLParser {
@@ -52,8 +55,14 @@ public:
 		return true;
 	}
 
+	/** Record the calls made to the theme engine while parsing into @p cache. */
+	void setCache(ThemeCache *cache) { _cache = cache; }
+
+	static Graphics::DrawingFunctionCallback getDrawingFunctionCallback(const Common::String &name);
+
 protected:
 	ThemeEngine *_theme;
+	ThemeCache *_cache;
 
 	CUSTOM_XML_PARSER(ThemeParser) {
 		XML_KEY(render_info)
@@ -269,6 +278,7 @@ protected:
 	Graphics::DrawStep *defaultDrawStep();
 	bool parseDrawStep(ParserNode *stepNode, Graphics::DrawStep *drawstep, bool functionSpecific);
 	bool parseCommonLayoutProps(ParserNode *node, const Common::String &var);
+	void setEvaluatorVar(const Common::String &name, int value);
 
 	bool parseList(const char *key, int count, ...);
 	bool parseList(const Common::String &keyStr, int count, ...);
@@ -31,6 +31,7 @@
 #include "common/md5.h"
 #include "common/archive.h"
 #include "common/macresman.h"
+#include "common/profiler.h"
 #include "common/stream.h"
 #endif
 
@@ -81,6 +82,9 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+#ifdef ENABLE_PROFILER
+	registerCmd("profiler",			WRAP_METHOD(Debugger, cmdProfiler));
+#endif
 }
 
 Debugger::~Debugger() {
@@ -857,6 +861,31 @@ bool Debugger::cmdDebugFlagDisable(int argc, const char **argv) {
 	return true;
 }
 
+#ifdef ENABLE_PROFILER
+bool Debugger::cmdProfiler(int argc, const char **argv) {
+	Common::Profiler &profiler = Common::Profiler::instance();
+
+	if (argc == 2 && !strcmp(argv[1], "start")) {
+		profiler.startCapture();
+		debugPrintf("Profiler capture started\n");
+	} else if (argc == 2 && !strcmp(argv[1], "stop")) {
+		profiler.stopCapture();
+		debugPrintf("Profiler capture stopped, %u zones captured\n", profiler.getCapturedCount());
+	} else if (argc == 3 && !strcmp(argv[1], "save")) {
+		Common::DumpFile file;
+		if (!file.open(Common::Path(argv[2], Common::Path::kNativeSeparator)) || !profiler.exportChromeTrace(file)) {
+			debugPrintf("Can't write file %s\n", argv[2]);
+			return true;
+		}
+		debugPrintf("Saved the capture to %s\n", argv[2]);
+	} else {
+		debugPrintf("Usage: %s start | stop | save <file>\n", argv[0]);
+		debugPrintf("Saved captures are Chrome trace event files (chrome://tracing, ui.perfetto.dev)\n");
+	}
+	return true;
+}
+#endif
+
 // Console handler
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 bool Debugger::debuggerInputCallback(GUI::ConsoleDialog *console, const char *input, void *refCon) {
@@ -277,6 +277,9 @@ protected:
 	bool cmdDebugFlagDisable(int argc, const char **argv);
 	bool cmdClearLog(int argc, const char **argv);
 	bool cmdExecFile(int argc, const char **argv);
+#ifdef ENABLE_PROFILER
+	bool cmdProfiler(int argc, const char **argv);
+#endif
 
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 private:
@@ -591,11 +591,18 @@ Common::Array<LauncherEntry> LauncherDialog::generateEntries(const Common::Confi
 
 		Common::StringMap &engineMap = _engines[engineid];
 		if (!engineMap.contains(gameid)) {
-			const Plugin *plugin = EngineMan.findDetectionPlugin(engineid);
-			if (plugin) {
-				PlainGameDescriptor gd = plugin->get<MetaEngineDetection>().findGame(gameid.c_str());
-				if (gd.description)
-					engineMap[gameid] = gd.description;
+			// Avoid loading the detection plugin if it has an index
+			Common::String gameDescription;
+			if (PluginMan.findIndexedGame(engineid, gameid, gameDescription)) {
+				if (!gameDescription.empty())
+					engineMap[gameid] = gameDescription;
+			} else {
+				const Plugin *plugin = EngineMan.findDetectionPlugin(engineid);
+				if (plugin) {
+					PlainGameDescriptor gd = plugin->get<MetaEngineDetection>().findGame(gameid.c_str());
+					if (gd.description)
+						engineMap[gameid] = gd.description;
+				}
 			}
 		}
 
@@ -1633,6 +1640,8 @@ void LauncherGrid::build() {
 
 	// Add list with game titles
 	_grid = new GridWidget(this, "LauncherGrid.IconArea");
+	// Let the grid load its thumbnails even when it does not have the focus
+	setTickleWidget(_grid);
 	// Populate the list
 	updateListing();
 
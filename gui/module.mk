@@ -27,6 +27,7 @@ MODULE_OBJS := \
 	shaderbrowser-dialog.o \
 	textviewer.o \
 	themebrowser.o \
+	ThemeCache.o \
 	ThemeEngine.o \
 	ThemeEval.o \
 	ThemeLayout.o \
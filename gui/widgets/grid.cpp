@@ -20,6 +20,7 @@
  */
 
 #include "common/system.h"
+#include "common/algorithm.h"
 #include "common/file.h"
 #include "common/language.h"
 #include "common/platform.h"
@@ -400,6 +401,12 @@ Graphics::ManagedSurface *loadSurfaceFromFile(const Common::String &name, int re
 
 #pragma mark -
 
+enum {
+	kThumbnailPrefetchRows = 2,					///< Rows loaded ahead above and below the visible ones
+	kThumbnailCacheSize = 32 * 1024 * 1024,		///< Memory used by the thumbnails before off-screen ones are evicted
+	kThumbnailLoadTime = 8						///< Time spent loading thumbnails per GUI tick, in milliseconds
+};
+
 GridWidget::GridWidget(GuiObject *boss, const Common::String &name)
 	: ContainerWidget(boss, name), CommandSender(boss) {
 
@@ -412,6 +419,8 @@ GridWidget::GridWidget(GuiObject *boss, const Common::String &name)
 	_extraIconHeight = 0;
 	_extraIconWidth = 0;
 	_disabledIconOverlay = nullptr;
+	_loadedSurfacesSize = 0;
+	_thumbnailStamp = 0;
 
 	_minGridXSpacing = 0;
 	_minGridYSpacing = 0;
@@ -445,13 +454,16 @@ GridWidget::GridWidget(GuiObject *boss, const Common::String &name)
 
 	_selectedEntry = nullptr;
 	_isGridInvalid = true;
+
+	// Thumbnails are loaded while the GUI is idle
+	setFlags(WIDGET_WANT_TICKLE);
 }
 
 GridWidget::~GridWidget() {
 	unloadSurfaces(_platformIcons);
 	unloadSurfaces(_languageIcons);
 	unloadSurfaces(_extraIcons);
-	unloadSurfaces(_loadedSurfaces);
+	unloadThumbnails();
 	delete _disabledIconOverlay;
 	_gridItems.clear();
 	_dataEntryList.clear();
@@ -474,7 +486,11 @@ void GridWidget::unloadSurfaces(Common::HashMap<T, const Graphics::ManagedSurfac
 const Graphics::ManagedSurface *GridWidget::filenameToSurface(const Common::String &name) {
 	if (name.empty())
 		return nullptr;
-	return _loadedSurfaces[name];
+
+	Common::HashMap<Common::String, LoadedThumbnail>::const_iterator thumb = _loadedSurfaces.find(name);
+	if (thumb == _loadedSurfaces.end())
+		return nullptr;
+	return thumb->_value.surface.get();
 }
 
 const Graphics::ManagedSurface *GridWidget::languageToSurface(Common::Language languageCode, Graphics::AlphaType &alphaType) {
@@ -507,6 +523,7 @@ void GridWidget::setEntryList(Common::Array<GridItemInfo> *list) {
 	_headerEntryList.clear();
 	_sortedEntryList.clear();
 	_visibleEntryList.clear();
+	_thumbnailQueue.clear();
 	_isGridInvalid = true;
 	_selectedEntry = nullptr;
 
@@ -698,50 +715,137 @@ void GridWidget::setGroupHeaderFormat(const Common::U32String &prefix, const Com
 }
 
 void GridWidget::reloadThumbnails() {
+	// The thumbnails are only queued here and loaded a few at a time from
+	// handleTickle(), so that the launcher opens and scrolls without waiting
+	// for all the icons to be decoded. The visible entries go first, then
+	// the rows below and above them.
+	_thumbnailStamp++;
+	_thumbnailQueue.clear();
+
+	for (Common::Array<GridItemInfo *>::iterator iter = _visibleEntryList.begin(); iter != _visibleEntryList.end(); ++iter)
+		queueThumbnail(*iter);
+
+	const int prefetch = kThumbnailPrefetchRows * MAX(_itemsPerRow, 1);
+	const int firstVisible = MIN(_firstVisibleItem, (int)_sortedEntryList.size());
+	const int end = MIN(firstVisible + (int)_visibleEntryList.size() + prefetch, (int)_sortedEntryList.size());
+	for (int i = firstVisible + _visibleEntryList.size(); i < end; ++i)
+		queueThumbnail(_sortedEntryList[i]);
+	for (int i = firstVisible - 1; i >= MAX(firstVisible - prefetch, 0); --i)
+		queueThumbnail(_sortedEntryList[i]);
+}
+
+void GridWidget::queueThumbnail(GridItemInfo *entry) {
+	if (entry->thumbPath.empty())
+		return;
+
+	Common::HashMap<Common::String, LoadedThumbnail>::iterator thumb = _loadedSurfaces.find(entry->thumbPath);
+	if (thumb != _loadedSurfaces.end())
+		thumb->_value.lastUsed = _thumbnailStamp;
+	else
+		_thumbnailQueue.push(entry);
+}
+
+void GridWidget::loadThumbnail(const GridItemInfo *entry) {
+	if (_loadedSurfaces.contains(entry->thumbPath))
+		return;
+
 	const int thumbnailWidth = MAX(_thumbnailWidth - 2 * _thumbnailMargin, 0);
 	const int thumbnailHeight = MAX(_thumbnailHeight - 2 * _thumbnailMargin, 0);
-	for (Common::Array<GridItemInfo *>::iterator iter = _visibleEntryList.begin(); iter != _visibleEntryList.end(); ++iter) {
-		GridItemInfo *entry = *iter;
-		if (entry->thumbPath.empty())
-			continue;
 
+	LoadedThumbnail thumb;
+	thumb.lastUsed = _thumbnailStamp;
+
+	Common::String path = Common::String::format("icons/%s-%s.png", entry->engineid.c_str(), entry->gameid.c_str());
+	Graphics::ManagedSurface *surf = nullptr;
+	if (!_thumbnailSources.contains(path)) {
+		surf = loadSurfaceFromFile(path);
+		if (!surf) {
+			// Fall back to the engine icon, which is shared by all its games
+			path = Common::String::format("icons/%s.png", entry->engineid.c_str());
+			if (!_thumbnailSources.contains(path))
+				surf = loadSurfaceFromFile(path);
+		}
+	}
+
+	if (surf) {
+		const Graphics::ManagedSurface *scSurf = scaleGfx(surf, thumbnailWidth, thumbnailHeight, true);
+		ThumbnailSource &source = _thumbnailSources[path];
+		source.surface = Common::SharedPtr<const Graphics::ManagedSurface>(scSurf);
+		source.size = scSurf->pitch * scSurf->h;
+		source.users = 0;
+		_loadedSurfacesSize += source.size;
+
+		if (surf != scSurf) {
+			surf->free();
+			delete surf;
+		}
+	}
+
+	Common::HashMap<Common::String, ThumbnailSource>::iterator source = _thumbnailSources.find(path);
+	if (source != _thumbnailSources.end()) {
+		source->_value.users++;
+		thumb.surface = source->_value.surface;
+		thumb.sourcePath = path;
+	}
+
+	_loadedSurfaces[entry->thumbPath] = thumb;
+}
+
+void GridWidget::loadQueuedThumbnails(uint32 timeBudget) {
+	if (_thumbnailQueue.empty())
+		return;
+
+	const uint32 startTime = g_system->getMillis();
+	Common::Array<Common::String> loaded;
+	do {
+		const GridItemInfo *entry = _thumbnailQueue.pop();
 		if (!_loadedSurfaces.contains(entry->thumbPath)) {
-			_loadedSurfaces[entry->thumbPath] = nullptr;
-			Common::String path = Common::String::format("icons/%s-%s.png", entry->engineid.c_str(), entry->gameid.c_str());
-			Graphics::ManagedSurface *surf = loadSurfaceFromFile(path);
-			if (!surf) {
-				path = Common::String::format("icons/%s.png", entry->engineid.c_str());
-				if (!_loadedSurfaces.contains(path)) {
-					surf = loadSurfaceFromFile(path);
-				} else {
-					const Graphics::ManagedSurface *scSurf = _loadedSurfaces[path];
-					// TODO: Use SharedPtr instead of duplicating the surface
-					Graphics::ManagedSurface *thSurf = new Graphics::ManagedSurface();
-					thSurf->copyFrom(*scSurf);
-					_loadedSurfaces[entry->thumbPath] = thSurf;
-				}
-			}
+			loadThumbnail(entry);
+			loaded.push_back(entry->thumbPath);
+		}
+	} while (!_thumbnailQueue.empty() && g_system->getMillis() - startTime < timeBudget);
 
-			if (surf) {
-				const Graphics::ManagedSurface *scSurf(scaleGfx(surf, thumbnailWidth, thumbnailHeight, true));
-				_loadedSurfaces[entry->thumbPath] = scSurf;
+	trimThumbnails();
 
-				if (path != entry->thumbPath) {
-					// TODO: Use SharedPtr instead of duplicating the surface
-					Graphics::ManagedSurface *thSurf = new Graphics::ManagedSurface();
-					thSurf->copyFrom(*scSurf);
-					_loadedSurfaces[path] = thSurf;
-				}
+	// Show the new thumbnails of the visible entries
+	for (uint k = 0; k < _visibleEntryList.size() && k < _gridItems.size(); ++k) {
+		if (Common::find(loaded.begin(), loaded.end(), _visibleEntryList[k]->thumbPath) != loaded.end())
+			_gridItems[k]->update();
+	}
+}
 
-				if (surf != scSurf) {
-					surf->free();
-					delete surf;
-				}
-			}
+void GridWidget::trimThumbnails() {
+	// Evict the thumbnails that have been off-screen for the longest time,
+	// but never those of the visible and prefetched entries
+	while (_loadedSurfacesSize > kThumbnailCacheSize) {
+		Common::HashMap<Common::String, LoadedThumbnail>::iterator oldest = _loadedSurfaces.end();
+		for (Common::HashMap<Common::String, LoadedThumbnail>::iterator i = _loadedSurfaces.begin(); i != _loadedSurfaces.end(); ++i) {
+			if (!i->_value.surface || i->_value.lastUsed == _thumbnailStamp)
+				continue;
+			if (oldest == _loadedSurfaces.end() || i->_value.lastUsed < oldest->_value.lastUsed)
+				oldest = i;
 		}
+
+		if (oldest == _loadedSurfaces.end())
+			break;
+
+		// Engine icons are shared, their memory is released with the last user
+		Common::HashMap<Common::String, ThumbnailSource>::iterator source = _thumbnailSources.find(oldest->_value.sourcePath);
+		if (source != _thumbnailSources.end() && --source->_value.users == 0) {
+			_loadedSurfacesSize -= source->_value.size;
+			_thumbnailSources.erase(source);
+		}
+		_loadedSurfaces.erase(oldest);
 	}
 }
 
+void GridWidget::unloadThumbnails() {
+	_loadedSurfaces.clear();
+	_thumbnailSources.clear();
+	_loadedSurfacesSize = 0;
+	_thumbnailQueue.clear();
+}
+
 void GridWidget::loadFlagIcons() {
 	const Common::LanguageDescription *l = Common::g_languages;
 	for (; l->code; ++l) {
@@ -1027,6 +1131,10 @@ void GridWidget::calcEntrySizes() {
 	}
 }
 
+void GridWidget::handleTickle() {
+	loadQueuedThumbnails(kThumbnailLoadTime);
+}
+
 void GridWidget::reflowLayout() {
 	Widget::reflowLayout();
 	destroyItems();
@@ -1072,7 +1180,7 @@ void GridWidget::reflowLayout() {
 		unloadSurfaces(_extraIcons);
 		unloadSurfaces(_platformIcons);
 		unloadSurfaces(_languageIcons);
-		unloadSurfaces(_loadedSurfaces);
+		unloadThumbnails();
 		_platformIconsAlpha.clear();
 		_languageIconsAlpha.clear();
 		_extraIconsAlpha.clear();
@@ -24,6 +24,8 @@
 
 #include "gui/dialog.h"
 #include "gui/widgets/scrollbar.h"
+#include "common/ptr.h"
+#include "common/queue.h"
 #include "common/str.h"
 
 #include "image/bmp.h"
@@ -106,8 +108,26 @@ protected:
 	Common::HashMap<int, Graphics::AlphaType> _languageIconsAlpha;
 	Common::HashMap<int, Graphics::AlphaType> _extraIconsAlpha;
 	Graphics::ManagedSurface *_disabledIconOverlay;
+
+	struct LoadedThumbnail {
+		Common::SharedPtr<const Graphics::ManagedSurface> surface; /// Scaled to the thumbnail size, nullptr if there is no icon
+		uint32 lastUsed; ///< Value of _thumbnailStamp when the entry was last visible or prefetched
+		Common::String sourcePath; ///< Key of the surface in _thumbnailSources
+	};
+	struct ThumbnailSource {
+		Common::SharedPtr<const Graphics::ManagedSurface> surface;
+		uint32 size; ///< Bytes counted in _loadedSurfacesSize
+		uint users; ///< Entries of _loadedSurfaces showing this surface
+	};
 	// Images are mapped by filename -> surface.
-	Common::HashMap<Common::String, const Graphics::ManagedSurface *> _loadedSurfaces;
+	Common::HashMap<Common::String, LoadedThumbnail> _loadedSurfaces;
+	// Surfaces mapped by the icon file they were loaded from, which is
+	// shared by all the games of an engine without an icon of their own.
+	Common::HashMap<Common::String, ThumbnailSource> _thumbnailSources;
+	uint32 _loadedSurfacesSize;
+	uint32 _thumbnailStamp;
+	// Entries whose thumbnail is still to be loaded, the visible ones first.
+	Common::Queue<GridItemInfo *> _thumbnailQueue;
 
 	Common::Array<GridItemInfo>			_dataEntryList;
 	Common::Array<GridItemInfo>			_headerEntryList;
@@ -198,6 +218,11 @@ public:
 	void saveClosedGroups(const Common::U32String &groupName);
 
 	void reloadThumbnails();
+	void queueThumbnail(GridItemInfo *entry);
+	void loadThumbnail(const GridItemInfo *entry);
+	void loadQueuedThumbnails(uint32 timeBudget);
+	void trimThumbnails();
+	void unloadThumbnails();
 	void loadFlagIcons();
 	void loadPlatformIcons();
 	void loadExtraIcons();
@@ -219,6 +244,7 @@ public:
 
 	void handleMouseWheel(int x, int y, int direction) override;
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
+	void handleTickle() override;
 	void reflowLayout() override;
 
 	bool wantsFocus() override { return true; }
@@ -0,0 +1,163 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/samplecache.h"
+#include "audio/audiostream.h"
+
+#include "common/memstream.h"
+
+#include "helper.h"
+
+static int g_factoryCalls = 0;
+
+static Audio::SeekableAudioStream *makeTestStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse) {
+	g_factoryCalls++;
+	return Audio::makeRawStream(stream, 11025, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN, disposeAfterUse);
+}
+
+class SampleCacheTestSuite : public CxxTest::TestSuite
+{
+	uint32 _savedBudget;
+
+public:
+	void setUp() {
+		_savedBudget = Audio::SampleCache::instance().getMemoryBudget();
+	}
+
+	void tearDown() {
+		Audio::SampleCache &cache = Audio::SampleCache::instance();
+		cache.clear();
+		cache.setMemoryBudget(_savedBudget);
+	}
+
+	void test_replay() {
+		Audio::SampleCache &cache = Audio::SampleCache::instance();
+		cache.setMemoryBudget(1024 * 1024);
+
+		int16 *sine;
+		const int totalSamples = 11025 * 2 * 2;
+		TS_ASSERT(!cache.getStream("sine"));
+		Audio::SeekableAudioStream *s = cache.addStream("sine", createSineStream<int16>(11025, 2, &sine, false, true));
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), (uint32)(totalSamples * sizeof(int16)));
+
+		// Every stream handed out plays the whole sample
+		for (int i = 0; i < 2; ++i) {
+			TS_ASSERT(s);
+			TS_ASSERT_EQUALS(s->isStereo(), true);
+			TS_ASSERT_EQUALS(s->getRate(), 11025);
+			TS_ASSERT_EQUALS(s->getLength().totalNumberOfFrames(), 11025 * 2);
+
+			int16 *buffer = new int16[totalSamples];
+			TS_ASSERT_EQUALS(s->readBuffer(buffer, totalSamples), totalSamples);
+			TS_ASSERT_EQUALS(memcmp(sine, buffer, sizeof(int16) * totalSamples), 0);
+			TS_ASSERT_EQUALS(s->endOfData(), true);
+
+			TS_ASSERT_EQUALS(s->seek(Audio::Timestamp(1000, 11025)), true);
+			TS_ASSERT_EQUALS(s->readBuffer(buffer, 2), 2);
+			TS_ASSERT_EQUALS(memcmp(sine + 11025 * 2, buffer, sizeof(int16) * 2), 0);
+
+			delete[] buffer;
+			delete s;
+			s = cache.getStream("sine");
+		}
+		delete s;
+
+		delete[] sine;
+		cache.clear();
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), 0u);
+	}
+
+	void test_eviction() {
+		Audio::SampleCache &cache = Audio::SampleCache::instance();
+		const uint32 sampleSize = 11025 * sizeof(int16);
+		cache.setMemoryBudget(sampleSize * 4);
+
+		int16 *sine;
+		const char *const keys[] = { "a", "b", "c", "d" };
+		for (int i = 0; i < ARRAYSIZE(keys); ++i) {
+			delete cache.addStream(keys[i], createSineStream<int16>(11025, 1, &sine, false, false));
+			delete[] sine;
+		}
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), sampleSize * 4);
+
+		// Using "a" makes "b" the least recently used sample
+		delete cache.getStream("a");
+		delete cache.addStream("e", createSineStream<int16>(11025, 1, &sine, false, false));
+		delete[] sine;
+
+		Audio::SeekableAudioStream *s = cache.getStream("b");
+		TS_ASSERT(!s);
+		delete s;
+		s = cache.getStream("a");
+		TS_ASSERT(s);
+		delete s;
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), sampleSize * 4);
+
+		cache.clear();
+	}
+
+	void test_too_large() {
+		Audio::SampleCache &cache = Audio::SampleCache::instance();
+		cache.setMemoryBudget(11025 * sizeof(int16));
+
+		// Samples which do not fit are handed back unchanged
+		int16 *sine;
+		Audio::SeekableAudioStream *s = cache.addStream("large", createSineStream<int16>(11025, 1, &sine, false, false));
+		TS_ASSERT(s);
+		TS_ASSERT(!cache.getStream("large"));
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), 0u);
+
+		int16 *buffer = new int16[11025];
+		TS_ASSERT_EQUALS(s->readBuffer(buffer, 11025), 11025);
+		TS_ASSERT_EQUALS(memcmp(sine, buffer, sizeof(int16) * 11025), 0);
+
+		delete[] buffer;
+		delete[] sine;
+		delete s;
+	}
+
+	void test_make_cached_stream() {
+		Audio::SampleCache::instance().setMemoryBudget(1024 * 1024);
+		g_factoryCalls = 0;
+
+		byte data[64];
+		for (int i = 0; i < ARRAYSIZE(data); ++i)
+			data[i] = i;
+
+		// The factory only runs for the first stream of a key
+		for (int i = 0; i < 2; ++i) {
+			Common::SeekableReadStream *compressed = new Common::MemoryReadStream(data, sizeof(data));
+			Audio::SeekableAudioStream *s = Audio::makeCachedStream("raw", compressed, DisposeAfterUse::YES, makeTestStream);
+			TS_ASSERT(s);
+			TS_ASSERT_EQUALS(g_factoryCalls, 1);
+
+			int16 buffer[32];
+			TS_ASSERT_EQUALS(s->readBuffer(buffer, 32), 32);
+			TS_ASSERT_EQUALS(buffer[1], (int16)READ_LE_UINT16(data + 2));
+			TS_ASSERT_EQUALS(s->endOfData(), true);
+			delete s;
+		}
+	}
+
+	void test_make_cached_adpcm_stream() {
+		Audio::SampleCache::instance().setMemoryBudget(1024 * 1024);
+
+		byte data[256];
+		for (int i = 0; i < ARRAYSIZE(data); ++i)
+			data[i] = (i * 37) & 0xFF;
+
+		Audio::SeekableAudioStream *expected = Audio::makeADPCMStream(new Common::MemoryReadStream(data, sizeof(data)), DisposeAfterUse::YES, sizeof(data), Audio::kADPCMOki, 11025, 1);
+		int16 expectedBuffer[512];
+		TS_ASSERT_EQUALS(expected->readBuffer(expectedBuffer, 512), 512);
+		delete expected;
+
+		for (int i = 0; i < 2; ++i) {
+			Audio::SeekableAudioStream *s = Audio::makeCachedADPCMStream("adpcm", new Common::MemoryReadStream(data, sizeof(data)), DisposeAfterUse::YES, sizeof(data), Audio::kADPCMOki, 11025, 1);
+			TS_ASSERT(s);
+			int16 buffer[512];
+			TS_ASSERT_EQUALS(s->readBuffer(buffer, 512), 512);
+			TS_ASSERT_EQUALS(memcmp(expectedBuffer, buffer, sizeof(buffer)), 0);
+			delete s;
+		}
+		TS_ASSERT_EQUALS(Audio::SampleCache::instance().getMemoryUsage(), 512 * sizeof(int16));
+	}
+};
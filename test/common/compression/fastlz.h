@@ -0,0 +1,195 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/compression/deflate.h"
+#include "common/compression/fastlz.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "../../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+/**
+ * A test suite for the fast LZ codec in common/compression/fastlz.h
+ */
+class FastLZTestSuite : public CxxTest::TestSuite {
+	/**
+	 * Fill a buffer with data resembling a save: runs of repeated records
+	 * with a few varying fields, and some noise.
+	 */
+	static void generateData(Common::Array<byte> &data, uint32 size, uint32 seed) {
+		data.resize(size);
+		for (uint32 i = 0; i < size; i++) {
+			seed = seed * 1103515245 + 12345;
+			if ((i / 4096) % 4 == 3)
+				data[i] = seed >> 16;
+			else
+				data[i] = (i % 24 < 16) ? "ScummVM save record #"[i % 16] : (byte)(i / 24);
+		}
+	}
+
+	static Common::SeekableReadStream *compressToStream(const Common::Array<byte> &data) {
+		Common::MemoryWriteStreamDynamic *out = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+		Common::ScopedPtr<Common::WriteStream> lz(Common::wrapFastLZWriteStream(out));
+		lz->write(data.data(), data.size());
+		lz->finalize();
+
+		byte *packed = (byte *)malloc(out->size());
+		memcpy(packed, out->getData(), out->size());
+		return new Common::MemoryReadStream(packed, out->size(), DisposeAfterUse::YES);
+	}
+
+public:
+	void test_block_roundtrip() {
+		Common::Array<byte> data, packed, unpacked;
+		generateData(data, Common::kFastLZBlockSize, 1);
+		packed.resize(data.size());
+		unpacked.resize(data.size());
+
+		uint32 packedSize = Common::compressFastLZ(data.data(), data.size(), packed.data());
+		TS_ASSERT(packedSize > 0);
+		TS_ASSERT(packedSize < data.size() / 2);
+		TS_ASSERT(Common::decompressFastLZ(packed.data(), packedSize, unpacked.data(), unpacked.size()));
+		TS_ASSERT(data == unpacked);
+
+		// The wrong size or a truncated block must be rejected
+		TS_ASSERT(!Common::decompressFastLZ(packed.data(), packedSize, unpacked.data(), unpacked.size() - 1));
+		TS_ASSERT(!Common::decompressFastLZ(packed.data(), packedSize - 1, unpacked.data(), unpacked.size()));
+	}
+
+	void test_block_incompressible() {
+		byte data[256], packed[256];
+		uint32 seed = 7;
+		for (uint i = 0; i < sizeof(data); i++) {
+			seed = seed * 1103515245 + 12345;
+			data[i] = seed >> 16;
+		}
+		TS_ASSERT_EQUALS(Common::compressFastLZ(data, sizeof(data), packed), 0u);
+		TS_ASSERT_EQUALS(Common::compressFastLZ(data, 0, packed), 0u);
+	}
+
+	void test_block_overlapping_match() {
+		byte data[1000], packed[1000], unpacked[1000];
+		for (uint i = 0; i < sizeof(data); i++)
+			data[i] = "abc"[i % 3];
+
+		uint32 packedSize = Common::compressFastLZ(data, sizeof(data), packed);
+		TS_ASSERT(packedSize > 0 && packedSize < 20);
+		TS_ASSERT(Common::decompressFastLZ(packed, packedSize, unpacked, sizeof(unpacked)));
+		TS_ASSERT(memcmp(data, unpacked, sizeof(data)) == 0);
+	}
+
+	void test_stream_roundtrip() {
+		Common::Array<byte> data;
+		generateData(data, 3 * Common::kFastLZBlockSize + 1234, 2);
+
+		Common::SeekableReadStream *packed = compressToStream(data);
+		Common::ScopedPtr<Common::SeekableReadStream> in(Common::wrapFastLZReadStream(packed));
+		TS_ASSERT(in.get() != packed);
+		TS_ASSERT_EQUALS(in->size(), (int64)data.size());
+
+		Common::Array<byte> unpacked(data.size());
+		TS_ASSERT_EQUALS(in->read(unpacked.data(), unpacked.size()), data.size());
+		TS_ASSERT(data == unpacked);
+		TS_ASSERT(!in->eos());
+		in->readByte();
+		TS_ASSERT(in->eos());
+		TS_ASSERT(!in->err());
+	}
+
+	void test_stream_checksum() {
+		Common::Array<byte> data;
+		generateData(data, 2 * Common::kFastLZBlockSize + 99, 5);
+
+		// Damage the checksum in the trailer
+		Common::ScopedPtr<Common::SeekableReadStream> packed(compressToStream(data));
+		const uint32 packedSize = packed->size();
+		byte *damaged = (byte *)malloc(packedSize);
+		packed->read(damaged, packedSize);
+		damaged[packedSize - 8] ^= 1;
+
+		Common::ScopedPtr<Common::SeekableReadStream> in(Common::wrapFastLZReadStream(new Common::MemoryReadStream(damaged, packedSize, DisposeAfterUse::YES)));
+		Common::Array<byte> unpacked(data.size() + 1);
+		TS_ASSERT_EQUALS(in->read(unpacked.data(), unpacked.size()), data.size());
+		TS_ASSERT(in->eos());
+		TS_ASSERT(in->err());
+	}
+
+	void test_stream_seek() {
+		Common::Array<byte> data;
+		generateData(data, 3 * Common::kFastLZBlockSize + 1234, 3);
+
+		Common::ScopedPtr<Common::SeekableReadStream> in(Common::wrapFastLZReadStream(compressToStream(data)));
+
+		// Forward over whole blocks, backward, and relative to the end
+		const int64 positions[] = { 2 * Common::kFastLZBlockSize + 17, 5, Common::kFastLZBlockSize - 2, (int64)data.size() - 3 };
+		for (uint i = 0; i < ARRAYSIZE(positions); i++) {
+			TS_ASSERT(in->seek(positions[i]));
+			TS_ASSERT_EQUALS(in->pos(), positions[i]);
+			TS_ASSERT_EQUALS(in->readByte(), data[positions[i]]);
+			TS_ASSERT_EQUALS(in->readByte(), data[positions[i] + 1]);
+		}
+
+		TS_ASSERT(in->seek(-1, SEEK_END));
+		TS_ASSERT_EQUALS(in->readByte(), data.back());
+		TS_ASSERT(!in->seek(1, SEEK_END));
+	}
+
+	void test_stream_passthrough() {
+		static const byte data[] = "Not compressed, longer than a header";
+		Common::SeekableReadStream *raw = new Common::MemoryReadStream(data, sizeof(data));
+		Common::ScopedPtr<Common::SeekableReadStream> in(Common::wrapFastLZReadStream(raw));
+		TS_ASSERT_EQUALS(in.get(), raw);
+		TS_ASSERT_EQUALS(in->pos(), 0);
+	}
+
+	void test_compression_speed() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+#ifdef SLOW_TESTS
+		const int iters = 50;
+#else
+		const int iters = 1;
+#endif
+
+		Common::Array<byte> data;
+		generateData(data, 4 * 1024 * 1024, 4);
+		Common::Array<byte> unpacked(data.size());
+
+		const char *const names[] = { "fast LZ", "deflate" };
+		for (int codec = 0; codec < 2; codec++) {
+#ifndef USE_ZLIB
+			if (codec == 1)
+				break;
+#endif
+			uint32 saveTime = 0, loadTime = 0, packedSize = 0;
+			for (int i = 0; i < iters; i++) {
+				uint32 start = g_system->getMillis();
+				Common::MemoryWriteStreamDynamic *out = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+				Common::ScopedPtr<Common::WriteStream> packer(codec ? Common::wrapCompressedWriteStream(out) : Common::wrapFastLZWriteStream(out));
+				packer->write(data.data(), data.size());
+				packer->finalize();
+				saveTime += g_system->getMillis() - start;
+
+				packedSize = out->size();
+				Common::SeekableReadStream *packed = new Common::MemoryReadStream(out->getData(), out->size());
+				start = g_system->getMillis();
+				Common::ScopedPtr<Common::SeekableReadStream> in(codec ? Common::wrapCompressedReadStream(packed) : Common::wrapFastLZReadStream(packed));
+				in->read(unpacked.data(), unpacked.size());
+				loadTime += g_system->getMillis() - start;
+				TS_ASSERT(data == unpacked);
+			}
+
+			debug("%s: %u bytes to %u, avg save time %u ms, load time %u ms\n", names[codec],
+				data.size(), packedSize, saveTime / iters, loadTime / iters);
+		}
+#endif
+	}
+};
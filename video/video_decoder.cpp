@@ -26,6 +26,7 @@
 
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
 namespace Video {
@@ -208,6 +209,7 @@ Graphics::PixelFormat VideoDecoder::getPixelFormat() const {
 }
 
 const Graphics::Surface *VideoDecoder::decodeNextFrame() {
+	PROFILE_ZONE("VideoDecoder::decodeNextFrame");
 	_needsUpdate = false;
 	_canSetDither = false;
 	_canSetDefaultFormat = false;